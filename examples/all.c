@@ -27,6 +27,13 @@ void test_datetime(pcf8523_t *pcf) {
     assert_ok(pcf8523_read_datetime(pcf, &rd), "read_datetime failed");
     printf("Datetime set/read OK: %02d:%02d:%02d %02d-%02d-%04d\n",
            rd.hour, rd.min, rd.sec, rd.day, rd.month, rd.year + BASE_CENTURY);
+
+    uint16_t health;
+    assert_ok(pcf8523_read_datetime_health(pcf, &rd, &health), "read_datetime_health failed");
+    printf("Health: OS=%d STOP=%d BLF=%d BSF=%d pending=0x%03x\n",
+           (health & PCF8523_HEALTH_OS) != 0, (health & PCF8523_HEALTH_STOP) != 0,
+           (health & PCF8523_HEALTH_BLF) != 0, (health & PCF8523_HEALTH_BSF) != 0,
+           health & PCF8523_HEALTH_PENDING_MASK);
 }
 
 void test_alarm(pcf8523_t *pcf) {
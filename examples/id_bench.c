@@ -0,0 +1,167 @@
+#ifdef PCF8523_HOST_BUILD
+#define _POSIX_C_SOURCE 199309L
+#include <time.h>
+#else
+#include "pico/stdlib.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "sensor/pcf8523.h"
+#include "sensor/pcf8523_id.h"
+
+// ID generation throughput and monotonicity across a backwards resync, on the host and on the
+// Pico. The RTC is an in-process register file, so no device has to be wired.
+
+#define ITERATIONS 1000000
+#define BATCH 64
+
+#define BASE_CENTURY 2000
+
+typedef struct {
+    uint8_t regs[PCF8523_REGISTER_COUNT];
+} fake_pcf8523_t;
+
+static bool fake_read(void *ctx, uint8_t i2cAddress, uint8_t startReg, uint8_t *data, size_t len) {
+    fake_pcf8523_t *fake = ctx;
+    (void)i2cAddress;
+
+    for (size_t i = 0; i < len; i++)
+        data[i] = fake->regs[(startReg + i) % PCF8523_REGISTER_COUNT];
+
+    return true;
+}
+
+static bool fake_write(void *ctx, uint8_t i2cAddress, const uint8_t *frame, size_t frameLen) {
+    fake_pcf8523_t *fake = ctx;
+    (void)i2cAddress;
+
+    for (size_t i = 1; i < frameLen; i++)
+        fake->regs[(frame[0] + i - 1) % PCF8523_REGISTER_COUNT] = frame[i];
+
+    return true;
+}
+
+static const pcf8523_Transport_t fake_transport = {
+    .read = fake_read,
+    .write = fake_write,
+};
+
+static uint64_t clock_us(void) {
+#ifdef PCF8523_HOST_BUILD
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)ts.tv_nsec / 1000ULL;
+#else
+    return time_us_64();
+#endif
+}
+
+static void report(const char *name, uint64_t elapsedUs, uint32_t count) {
+    printf("%-22s %8.1f ns/id %10.0f ids/s\n", name, (double)elapsedUs * 1000.0 / count,
+           (double)count * 1e6 / (double)elapsedUs);
+}
+
+static bool check_order(const pcf8523_Id128_t *prev, const pcf8523_Id128_t *id) {
+    return memcmp(prev->bytes, id->bytes, sizeof(id->bytes)) < 0;
+}
+
+static pcf8523_Id128_t ids[BATCH];
+
+int main(void) {
+#ifndef PCF8523_HOST_BUILD
+    stdio_init_all();
+    sleep_ms(2000);
+#endif
+
+    fake_pcf8523_t fake = {0};
+    pcf8523_t pcf8523;
+    if (!pcf8523_init_struct_transport(&pcf8523, &fake_transport, &fake, PCF8523_DEFAULT_ADDR,
+                                       true, false)) {
+        printf("Error initializating the struct\n");
+        return -1;
+    }
+
+    pcf8523_Datetime_t datetime = {
+        .sec = 56,
+        .min = 34,
+        .hour = 12,
+        .hourMode = PCF8523_HOUR_MODE_24H,
+        .day = 28,
+        .weekDay = 3,
+        .month = 2,
+        .year = 24,
+    };
+    if (!pcf8523_set_datetime(&pcf8523, &datetime)) {
+        printf("Error setting the datetime\n");
+        return -1;
+    }
+
+    pcf8523_IdGen_t gen;
+    if (!pcf8523_id_init(&gen, &pcf8523, BASE_CENTURY, clock_us, 0x5EED0001)) {
+        printf("Error initializating the generator\n");
+        return -1;
+    }
+
+    pcf8523_Id128_t prev;
+    pcf8523_Id128_t id;
+    uint32_t errors = 0;
+
+    pcf8523_id_next128(&gen, &prev);
+
+    uint64_t start = clock_us();
+    for (uint32_t i = 0; i < ITERATIONS; i++) {
+        pcf8523_id_next128(&gen, &id);
+        errors += !check_order(&prev, &id);
+        prev = id;
+    }
+    report("next128", clock_us() - start, ITERATIONS);
+
+    start = clock_us();
+    for (uint32_t i = 0; i < ITERATIONS / BATCH; i++) {
+        pcf8523_id_next128_batch(&gen, ids, BATCH);
+        errors += !check_order(&prev, &ids[0]);
+        prev = ids[BATCH - 1];
+    }
+    report("next128_batch", clock_us() - start, ITERATIONS / BATCH * BATCH);
+
+    uint64_t prev64 = pcf8523_id_next64(&gen);
+    start = clock_us();
+    for (uint32_t i = 0; i < ITERATIONS; i++) {
+        uint64_t id64 = pcf8523_id_next64(&gen);
+        errors += id64 <= prev64;
+        prev64 = id64;
+    }
+    report("next64", clock_us() - start, ITERATIONS);
+
+    // The RTC is set 5 s back, the IDs carry on from the last timestamp
+    datetime.sec = 51;
+    if (!pcf8523_set_datetime(&pcf8523, &datetime) || !pcf8523_id_resync(&gen)) {
+        printf("Error resyncing\n");
+        return -1;
+    }
+
+    for (uint32_t i = 0; i < 100000; i++) {
+        pcf8523_id_next128(&gen, &id);
+        errors += !check_order(&prev, &id);
+        prev = id;
+
+        uint64_t id64 = pcf8523_id_next64(&gen);
+        errors += id64 <= prev64;
+        prev64 = id64;
+    }
+
+    char uuid[PCF8523_ID_UUID_LEN];
+    char ulid[PCF8523_ID_ULID_LEN];
+    pcf8523_id_format_uuid(&id, uuid);
+    pcf8523_id_format_ulid(&id, ulid);
+
+    printf("last: %s %s 0x%016llx\n", uuid, ulid, (unsigned long long)prev64);
+    printf("resyncs %lu, adjustments %lu, carried %lu, order errors %lu\n",
+           (unsigned long)gen.resyncs, (unsigned long)gen.adjustments, (unsigned long)gen.carried,
+           (unsigned long)errors);
+
+    return errors == 0 ? 0 : -1;
+}
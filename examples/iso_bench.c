@@ -0,0 +1,109 @@
+#ifdef PCF8523_HOST_BUILD
+#define _POSIX_C_SOURCE 199309L
+#include <time.h>
+#else
+#include "pico/stdlib.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "sensor/pcf8523.h"
+#include "sensor/pcf8523_iso.h"
+
+// ISO 8601 timestamps with pcf8523_iso against snprintf / sscanf, on the host and on the Pico
+
+#define ITERATIONS 20000
+
+static double now_us(void) {
+#ifdef PCF8523_HOST_BUILD
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e6 + (double)ts.tv_nsec / 1e3;
+#else
+    return (double)time_us_64();
+#endif
+}
+
+// Keeps the compiler from dropping the loops
+static volatile uint32_t sink;
+
+static void report(const char *name, double elapsed) {
+    printf("%-28s %8.3f us/call\n", name, elapsed / ITERATIONS);
+}
+
+int main(void) {
+#ifndef PCF8523_HOST_BUILD
+    stdio_init_all();
+    sleep_ms(2000);
+#endif
+
+    pcf8523_Datetime_t datetime = {
+        .sec = 56,
+        .min = 34,
+        .hour = 12,
+        .hourMode = PCF8523_HOUR_MODE_24H,
+        .day = 28,
+        .weekDay = 3,
+        .month = 2,
+        .year = 24,
+    };
+    pcf8523_IsoOptions_t options = {
+        .fraction = 123,
+        .fractionDigits = 3,
+        .offsetMin = PCF8523_ISO_UTC,
+    };
+    char buffer[PCF8523_ISO_MAX_LEN];
+
+    double start = now_us();
+    for (uint32_t i = 0; i < ITERATIONS; i++) {
+        datetime.sec = (uint8_t)(i % 60);
+        sink += (uint32_t)pcf8523_iso_format(&datetime, 2000, &options, buffer, sizeof(buffer));
+    }
+    report("pcf8523_iso_format", now_us() - start);
+
+    start = now_us();
+    for (uint32_t i = 0; i < ITERATIONS; i++) {
+        datetime.sec = (uint8_t)(i % 60);
+        sink += (uint32_t)snprintf(buffer, sizeof(buffer), "%04u-%02u-%02uT%02u:%02u:%02u.%03luZ",
+                                   2000u + datetime.year, datetime.month, datetime.day,
+                                   datetime.hour, datetime.min, datetime.sec,
+                                   (unsigned long)options.fraction);
+    }
+    report("snprintf", now_us() - start);
+
+    uint64_t epoch = pcf8523_datetime_to_epoch(&datetime, 2000);
+    start = now_us();
+    for (uint32_t i = 0; i < ITERATIONS; i++)
+        sink += (uint32_t)pcf8523_iso_format_epoch(epoch + i, &options, buffer, sizeof(buffer));
+    report("pcf8523_iso_format_epoch", now_us() - start);
+
+    const char *text = "2024-02-28T12:34:56.123Z";
+    uint32_t nanos;
+
+    start = now_us();
+    for (uint32_t i = 0; i < ITERATIONS; i++) {
+        uint16_t century;
+        sink += (uint32_t)pcf8523_iso_parse(text, &datetime, &century, &nanos, NULL);
+    }
+    report("pcf8523_iso_parse", now_us() - start);
+
+    start = now_us();
+    for (uint32_t i = 0; i < ITERATIONS; i++) {
+        unsigned year, month, day, hour, min, sec, ms;
+        sink += (uint32_t)sscanf(text, "%4u-%2u-%2uT%2u:%2u:%2u.%3uZ", &year, &month, &day, &hour,
+                                 &min, &sec, &ms);
+    }
+    report("sscanf", now_us() - start);
+
+    start = now_us();
+    for (uint32_t i = 0; i < ITERATIONS; i++)
+        sink += (uint32_t)pcf8523_iso_parse_epoch(text, &epoch, &nanos);
+    report("pcf8523_iso_parse_epoch", now_us() - start);
+
+    pcf8523_iso_format(&datetime, 2000, &options, buffer, sizeof(buffer));
+    printf("%s\n", buffer);
+
+    return 0;
+}
@@ -0,0 +1,140 @@
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "sensor/pcf8523.h"
+#include "sensor/pcf8523_linux.h"
+
+// Usage: linux_bench /dev/i2c-N [iterations]  (a PCF8523 or the i2c-stub module at 0x68)
+//        linux_bench --fake [iterations]      (in-process register file, no kernel involved)
+
+#define DEFAULT_ITERATIONS 10000
+
+typedef struct {
+    uint8_t regs[PCF8523_REGISTER_COUNT];
+    uint32_t transfers;
+} fake_pcf8523_t;
+
+static bool fake_read(void *ctx, uint8_t i2cAddress, uint8_t startReg, uint8_t *data, size_t len) {
+    fake_pcf8523_t *fake = ctx;
+    (void)i2cAddress;
+
+    fake->transfers++;
+    for (size_t i = 0; i < len; i++)
+        data[i] = fake->regs[(startReg + i) % PCF8523_REGISTER_COUNT];
+
+    return true;
+}
+
+static bool fake_write(void *ctx, uint8_t i2cAddress, const uint8_t *frame, size_t frameLen) {
+    fake_pcf8523_t *fake = ctx;
+    (void)i2cAddress;
+
+    fake->transfers++;
+    for (size_t i = 1; i < frameLen; i++)
+        fake->regs[(frame[0] + i - 1) % PCF8523_REGISTER_COUNT] = frame[i];
+
+    return true;
+}
+
+static const pcf8523_Transport_t fake_transport = {
+    .read = fake_read,
+    .write = fake_write,
+};
+
+static double now_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e6 + (double)ts.tv_nsec / 1e3;
+}
+
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        printf("Usage: %s </dev/i2c-N | --fake> [iterations]\n", argv[0]);
+        return -1;
+    }
+
+    long iterations = argc > 2 ? atol(argv[2]) : DEFAULT_ITERATIONS;
+    if (iterations <= 0)
+        iterations = DEFAULT_ITERATIONS;
+
+    pcf8523_t pcf8523;
+    pcf8523_LinuxI2c_t bus = {.fd = -1};
+    fake_pcf8523_t fake = {0};
+    uint32_t *transfers;
+
+    if (strcmp(argv[1], "--fake") == 0) {
+        if (!pcf8523_init_struct_transport(&pcf8523, &fake_transport, &fake, PCF8523_DEFAULT_ADDR,
+                                           true, false)) {
+            printf("Error initializating the struct\n");
+            return -1;
+        }
+        transfers = &fake.transfers;
+    }
+    else {
+        if (!pcf8523_linux_i2c_open(&bus, argv[1])) {
+            printf("Error opening %s\n", argv[1]);
+            return -1;
+        }
+        if (!pcf8523_init_struct_transport(&pcf8523, &pcf8523_linux_transport, &bus,
+                                           PCF8523_DEFAULT_ADDR, true, false)) {
+            printf("Error initializating the struct\n");
+            return -1;
+        }
+        transfers = &bus.transfers;
+    }
+
+    pcf8523_Datetime_t datetime = {
+        .sec = 0,
+        .min = 0,
+        .hour = 12,
+        .hourMode = PCF8523_HOUR_MODE_24H,
+        .day = 1,
+        .weekDay = 6,
+        .month = 1,
+        .year = 0,
+    };
+
+    uint32_t before = *transfers;
+    double start = now_us();
+    for (long i = 0; i < iterations; i++) {
+        if (!pcf8523_set_datetime(&pcf8523, &datetime)) {
+            printf("Error setting the datetime\n");
+            return -1;
+        }
+    }
+    double elapsed = now_us() - start;
+    printf("set_datetime:  %.2f transfers/call, %.2f us/call\n",
+           (double)(*transfers - before) / (double)iterations, elapsed / (double)iterations);
+
+    before = *transfers;
+    start = now_us();
+    for (long i = 0; i < iterations; i++) {
+        if (!pcf8523_read_datetime(&pcf8523, &datetime)) {
+            printf("Error reading the datetime\n");
+            return -1;
+        }
+    }
+    elapsed = now_us() - start;
+    printf("read_datetime: %.2f transfers/call, %.2f us/call\n",
+           (double)(*transfers - before) / (double)iterations, elapsed / (double)iterations);
+
+    uint16_t health;
+    before = *transfers;
+    start = now_us();
+    for (long i = 0; i < iterations; i++) {
+        if (!pcf8523_read_datetime_health(&pcf8523, &datetime, &health)) {
+            printf("Error reading the datetime\n");
+            return -1;
+        }
+    }
+    elapsed = now_us() - start;
+    printf("read_datetime_health: %.2f transfers/call, %.2f us/call\n",
+           (double)(*transfers - before) / (double)iterations, elapsed / (double)iterations);
+
+    pcf8523_linux_i2c_close(&bus);
+
+    return 0;
+}
@@ -0,0 +1,279 @@
+#define _POSIX_C_SOURCE 200809L
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "sensor/pcf8523_log.h"
+
+// Usage: log_sim [image]
+//
+// Runs the flash ring log against a file with NOR semantics (erase sets a block to 0xFF, program
+// can only clear bits), the same contract the Pico flash backend has. The image (log_sim.img by
+// default) is recreated on every run and can be inspected afterwards.
+//
+// The log is filled past its capacity so the ring wraps, time ranges are looked up, and it is
+// mounted again from the file after a clean stop and after two power losses: one in the middle
+// of a record and one while a new block header was being written. The program stops as soon as
+// the flash has received a given number of bytes, which is what a torn write leaves behind.
+
+#define BLOCK_SIZE 4096
+#define BLOCK_COUNT 4
+#define RECORD_SIZE 16
+
+#define FIRST_EPOCH 1700000000UL
+#define EPOCH_STEP 10
+
+typedef struct {
+    int fd;
+    int32_t tearAfter; // Bytes the next program calls may still write, negative for no limit
+    bool powerLost;
+} file_flash_t;
+
+typedef struct {
+    uint32_t index;
+    uint8_t fill[RECORD_SIZE - 4];
+} sim_record_t;
+
+static bool file_read(void *ctx, uint32_t offset, uint8_t *data, size_t len) {
+    file_flash_t *flash = ctx;
+
+    if (flash->powerLost || offset + len > (size_t)BLOCK_SIZE * BLOCK_COUNT)
+        return false;
+
+    return pread(flash->fd, data, len, (off_t)offset) == (ssize_t)len;
+}
+
+static bool file_program(void *ctx, uint32_t offset, const uint8_t *data, size_t len) {
+    file_flash_t *flash = ctx;
+    uint8_t cell;
+
+    if (flash->powerLost || offset + len > (size_t)BLOCK_SIZE * BLOCK_COUNT)
+        return false;
+
+    for (size_t i = 0; i < len; i++) {
+        if (flash->tearAfter == 0) {
+            flash->powerLost = true;
+            return false;
+        }
+        if (flash->tearAfter > 0)
+            flash->tearAfter--;
+
+        if (pread(flash->fd, &cell, 1, (off_t)(offset + i)) != 1)
+            return false;
+
+        cell &= data[i];
+        if (pwrite(flash->fd, &cell, 1, (off_t)(offset + i)) != 1)
+            return false;
+    }
+
+    return true;
+}
+
+static bool file_erase(void *ctx, uint32_t offset, size_t len) {
+    file_flash_t *flash = ctx;
+    uint8_t erased[BLOCK_SIZE];
+
+    if (flash->powerLost || (offset % BLOCK_SIZE) != 0 || (len % BLOCK_SIZE) != 0 ||
+        offset + len > (size_t)BLOCK_SIZE * BLOCK_COUNT)
+        return false;
+
+    memset(erased, 0xFF, sizeof(erased));
+    for (size_t done = 0; done < len; done += BLOCK_SIZE) {
+        if (pwrite(flash->fd, erased, BLOCK_SIZE, (off_t)(offset + done)) != BLOCK_SIZE)
+            return false;
+    }
+
+    return true;
+}
+
+static uint32_t record_epoch(uint32_t index) {
+    return (uint32_t)(FIRST_EPOCH + (uint64_t)index * EPOCH_STEP);
+}
+
+static bool append(pcf8523_Log_t *log, uint32_t index) {
+    sim_record_t record;
+
+    record.index = index;
+    memset(record.fill, (int)(index & 0xFF), sizeof(record.fill));
+
+    return pcf8523_log_append(log, record_epoch(index), &record);
+}
+
+// Walks the whole log, every valid record has to be the one after the previous
+static bool walk(pcf8523_Log_t *log, uint32_t *first, uint32_t *last, uint32_t *valid) {
+    pcf8523_LogCursor_t cursor;
+    sim_record_t record;
+    uint32_t epoch;
+
+    *valid = 0;
+    if (!pcf8523_log_find(log, 0, &cursor))
+        return false;
+
+    while (pcf8523_log_next(log, &cursor, UINT32_MAX, &epoch, &record)) {
+        if (epoch != record_epoch(record.index))
+            return false;
+
+        if (*valid == 0)
+            *first = record.index;
+        else if (record.index != *last + 1)
+            return false;
+
+        *last = record.index;
+        (*valid)++;
+    }
+
+    return true;
+}
+
+// Records from fromEpoch to toEpoch must start at the first index not before fromEpoch
+static bool lookup(pcf8523_Log_t *log, uint32_t fromEpoch, uint32_t toEpoch, uint32_t oldest,
+                   uint32_t newest) {
+    pcf8523_LogCursor_t cursor;
+    sim_record_t record;
+    uint32_t epoch;
+
+    uint32_t expected = oldest;
+    if (fromEpoch > record_epoch(oldest))
+        expected = (uint32_t)((fromEpoch - FIRST_EPOCH + EPOCH_STEP - 1) / EPOCH_STEP);
+
+    if (!pcf8523_log_find(log, fromEpoch, &cursor))
+        return false;
+
+    while (pcf8523_log_next(log, &cursor, toEpoch, &epoch, &record)) {
+        if (record.index != expected || epoch < fromEpoch)
+            return false;
+        expected++;
+    }
+
+    // Every record up to toEpoch (or the newest) was returned
+    return expected > newest || record_epoch(expected) > toEpoch;
+}
+
+static bool mount(pcf8523_Log_t *log, const pcf8523_LogFlash_t *flash, uint32_t *index,
+                  const char *when, uint32_t *first, uint32_t *last) {
+    uint32_t valid;
+
+    if (!pcf8523_log_init(log, flash, BLOCK_COUNT, RECORD_SIZE, index) ||
+        !walk(log, first, last, &valid)) {
+        printf("%-25s mount failed\n", when);
+        return false;
+    }
+
+    printf("%-25s %4lu slots, %4lu valid records %lu..%lu, last epoch %lu\n", when,
+           (unsigned long)pcf8523_log_count(log), (unsigned long)valid, (unsigned long)*first,
+           (unsigned long)*last, (unsigned long)log->lastEpoch);
+
+    return true;
+}
+
+int main(int argc, char **argv) {
+    const char *path = argc > 1 ? argv[1] : "log_sim.img";
+
+    file_flash_t file = {.tearAfter = -1};
+    file.fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (file.fd < 0 || ftruncate(file.fd, (off_t)BLOCK_SIZE * BLOCK_COUNT) != 0) {
+        printf("Error creating %s\n", path);
+        return -1;
+    }
+
+    pcf8523_LogFlash_t flash = {
+        .read = file_read,
+        .program = file_program,
+        .erase = file_erase,
+        .ctx = &file,
+        .blockSize = BLOCK_SIZE,
+    };
+
+    pcf8523_Log_t log;
+    uint32_t index[BLOCK_COUNT];
+    uint32_t first = 0;
+    uint32_t last = 0;
+    uint32_t failures = 0;
+
+    if (!pcf8523_log_init(&log, &flash, BLOCK_COUNT, RECORD_SIZE, index) ||
+        !pcf8523_log_format(&log)) {
+        printf("Error formatting the log\n");
+        return -1;
+    }
+
+    // Two and a half times the capacity, so the oldest blocks are recycled twice
+    uint32_t capacity = (uint32_t)log.slotsPerBlock * BLOCK_COUNT;
+    uint32_t written = capacity * 5 / 2;
+    for (uint32_t i = 0; i < written; i++) {
+        if (!append(&log, i)) {
+            printf("Error appending record %lu\n", (unsigned long)i);
+            return -1;
+        }
+    }
+
+    if (!mount(&log, &flash, index, "after wrap", &first, &last))
+        return -1;
+    failures += last != written - 1 || pcf8523_log_count(&log) != last - first + 1;
+    failures += pcf8523_log_count(&log) <= capacity - log.slotsPerBlock;
+
+    uint32_t lookups = 0;
+    uint32_t misses = 0;
+    for (uint32_t from = record_epoch(first) - 3 * EPOCH_STEP; from < record_epoch(last) + 50;
+         from += 7 * EPOCH_STEP + 3) {
+        misses += !lookup(&log, from, from + 40 * EPOCH_STEP, first, last);
+        lookups++;
+    }
+    printf("%-25s %4lu ranges, %lu wrong\n", "lookup", (unsigned long)lookups,
+           (unsigned long)misses);
+    failures += misses;
+
+    // Power lost 10 bytes into a record in the middle of the head block: epoch and part of the
+    // payload are there, the CRC is not
+    for (uint32_t i = 0; i < 5; i++) {
+        last++;
+        failures += !append(&log, last);
+    }
+
+    uint32_t before = last;
+    file.tearAfter = 10;
+    failures += append(&log, last + 1);
+    file.tearAfter = -1;
+    file.powerLost = false;
+
+    if (!mount(&log, &flash, index, "after torn record", &first, &last))
+        return -1;
+    failures += last != before || log.lastEpoch != record_epoch(before);
+    failures += pcf8523_log_count(&log) != last - first + 2;
+
+    // The slot stays burnt, the next record goes after it and is found as usual
+    failures += !append(&log, last + 1);
+    if (!mount(&log, &flash, index, "append after torn record", &first, &last))
+        return -1;
+    failures += last != before + 1 || !lookup(&log, record_epoch(last), UINT32_MAX, first, last);
+
+    // Fill the head block, then lose power while the recycled block gets its header
+    while (log.headSlot < log.slotsPerBlock) {
+        last++;
+        failures += !append(&log, last);
+    }
+
+    before = last;
+    file.tearAfter = PCF8523_LOG_HEADER_SIZE / 2;
+    failures += append(&log, last + 1);
+    file.tearAfter = -1;
+    file.powerLost = false;
+
+    uint32_t oldest = first;
+    if (!mount(&log, &flash, index, "after torn header", &first, &last))
+        return -1;
+    failures += last != before || first != oldest + log.slotsPerBlock ||
+                log.usedBlocks != BLOCK_COUNT - 1;
+
+    // The half written block is erased again when the ring reaches it
+    failures += !append(&log, last + 1);
+    if (!mount(&log, &flash, index, "append after torn header", &first, &last))
+        return -1;
+    failures += last != before + 1 || log.usedBlocks != BLOCK_COUNT;
+
+    close(file.fd);
+    printf("%s\n", failures == 0 ? "OK" : "FAILED");
+
+    return failures == 0 ? 0 : -1;
+}
@@ -0,0 +1,185 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+
+#include "sensor/pcf8523.h"
+#include "sensor/pcf8523_rtos.h"
+
+// pcf8523_rtos on the FreeRTOS POSIX port against a simulated device. The bus completes every
+// transfer one tick later from a timer, and a 1 Hz timer plays the role of the second interrupt on
+// INT1. Two tasks share the device while a third one receives the INT1 events.
+
+#define SIM_EVENTS 5
+#define SIM_SF_MASK (1 << 4)
+
+typedef struct {
+    uint8_t regs[PCF8523_REGISTER_COUNT];
+    TimerHandle_t completion;
+    pcf8523_Rtos_t *rtos;
+    uint32_t transfers;
+} sim_device_t;
+
+static sim_device_t sim;
+static pcf8523_t pcf8523;
+static pcf8523_Rtos_t rtos;
+
+static void sim_complete(TimerHandle_t timer) {
+    (void)timer;
+    pcf8523_rtos_transfer_done(sim.rtos, true);
+}
+
+// Synchronous access, only used before the scheduler starts
+static bool sim_read(void *ctx, uint8_t i2cAddress, uint8_t startReg, uint8_t *data, size_t len) {
+    sim_device_t *dev = ctx;
+    (void)i2cAddress;
+
+    for (size_t i = 0; i < len; i++)
+        data[i] = dev->regs[(startReg + i) % PCF8523_REGISTER_COUNT];
+    dev->transfers++;
+
+    return true;
+}
+
+static bool sim_write(void *ctx, uint8_t i2cAddress, const uint8_t *frame, size_t frameLen) {
+    sim_device_t *dev = ctx;
+    (void)i2cAddress;
+
+    for (size_t i = 1; i < frameLen; i++) {
+        uint8_t reg = (uint8_t)((frame[0] + i - 1) % PCF8523_REGISTER_COUNT);
+        uint8_t value = frame[i];
+
+        // Flags are cleared by writing 0 and can not be set over the bus
+        if (reg == PCF8523_CTRL2_REG)
+            value = (uint8_t)((value & 0x07) | (dev->regs[reg] & value & 0xF8));
+        else if (reg == PCF8523_CTRL3_REG)
+            value = (uint8_t)((value & 0xF3) | (dev->regs[reg] & value & 0x0C));
+        dev->regs[reg] = value;
+    }
+    dev->transfers++;
+
+    return true;
+}
+
+static const pcf8523_Transport_t sim_transport = {
+    .read = sim_read,
+    .write = sim_write,
+};
+
+// The bus backend moves the data right away and reports the completion one tick later
+static bool sim_start_read(void *ctx, uint8_t i2cAddress, uint8_t startReg, uint8_t *data,
+                           size_t len) {
+    sim_device_t *dev = ctx;
+
+    taskENTER_CRITICAL();
+    sim_read(dev, i2cAddress, startReg, data, len);
+    taskEXIT_CRITICAL();
+
+    return xTimerStart(dev->completion, 0) == pdPASS;
+}
+
+static bool sim_start_write(void *ctx, uint8_t i2cAddress, const uint8_t *frame,
+                            size_t frameLen) {
+    sim_device_t *dev = ctx;
+
+    taskENTER_CRITICAL();
+    sim_write(dev, i2cAddress, frame, frameLen);
+    taskEXIT_CRITICAL();
+
+    return xTimerStart(dev->completion, 0) == pdPASS;
+}
+
+static const pcf8523_RtosBus_t sim_bus = {
+    .start_read = sim_start_read,
+    .start_write = sim_start_write,
+};
+
+static void sim_second(TimerHandle_t timer) {
+    (void)timer;
+
+    taskENTER_CRITICAL();
+    uint8_t sec = (uint8_t)(sim.regs[PCF8523_SECONDS_REG] + 1);
+    if ((sec & 0x0F) > 9)
+        sec = (uint8_t)(sec + 6);
+    sim.regs[PCF8523_SECONDS_REG] = sec >= 0x60 ? 0 : sec;
+
+    bool irq = sim.regs[PCF8523_CTRL1_REG] & PCF8523_CTRL1_ENABLE_SECOND_INT_MASK;
+    if (irq)
+        sim.regs[PCF8523_CTRL2_REG] |= SIM_SF_MASK;
+    taskEXIT_CRITICAL();
+
+    if (irq)
+        pcf8523_rtos_signal_int(&rtos);
+}
+
+static void reader_task(void *param) {
+    (void)param;
+    pcf8523_Datetime_t datetime;
+
+    for (;;) {
+        if (!pcf8523_read_datetime(&pcf8523, &datetime))
+            printf("reader: read failed\n");
+        vTaskDelay(pdMS_TO_TICKS(50));
+    }
+}
+
+static void app_task(void *param) {
+    (void)param;
+
+    if (!pcf8523_enable_interrupt_source(&pcf8523, PCF8523_CTRL1_REG,
+                                         PCF8523_CTRL1_ENABLE_SECOND_INT_MASK, true)) {
+        printf("app: enabling the second interrupt failed\n");
+        exit(1);
+    }
+
+    for (int i = 0; i < SIM_EVENTS; i++) {
+        pcf8523_RtosEvent_t event;
+        if (!pcf8523_rtos_wait_event(&rtos, &event, pdMS_TO_TICKS(3000))) {
+            printf("app: no event\n");
+            exit(1);
+        }
+
+        printf("app: tick %lu ctrl2 flags 0x%02x ctrl3 flags 0x%02x\n", (unsigned long)event.tick,
+               event.ctrl2Flags, event.ctrl3Flags);
+    }
+
+    bool pending;
+    if (!pcf8523_read_interrupt_flag(&pcf8523, PCF8523_CTRL2_REG,
+                                     PCF8523_CTRL2_SECOND_INT_FLAG_MASK, &pending))
+        exit(1);
+
+    printf("transfers %lu, timeouts %lu, dropped events %lu, SF pending %d\n",
+           (unsigned long)sim.transfers, (unsigned long)rtos.timeouts,
+           (unsigned long)rtos.droppedEvents, pending);
+
+    exit(rtos.timeouts == 0 && rtos.droppedEvents == 0 ? 0 : 1);
+}
+
+int main(void) {
+    sim.rtos = &rtos;
+    sim.completion = xTimerCreate("sim_bus", 1, pdFALSE, NULL, sim_complete);
+    TimerHandle_t second = xTimerCreate("sim_sec", pdMS_TO_TICKS(1000), pdTRUE, NULL, sim_second);
+
+    if (!pcf8523_init_struct_transport(&pcf8523, &sim_transport, &sim, PCF8523_DEFAULT_ADDR, true,
+                                       false)) {
+        printf("Error initializating the struct\n");
+        return 1;
+    }
+
+    if (!pcf8523_rtos_init(&rtos, &pcf8523, &sim_bus, &sim, pdMS_TO_TICKS(100))) {
+        printf("Error initializating the rtos layer\n");
+        return 1;
+    }
+
+    pcf8523_rtos_start_int_task(&rtos, tskIDLE_PRIORITY + 3, configMINIMAL_STACK_SIZE);
+    xTaskCreate(app_task, "app", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY + 2, NULL);
+    xTaskCreate(reader_task, "reader", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY + 1, NULL);
+
+    xTimerStart(second, 0);
+    vTaskStartScheduler();
+
+    return 0;
+}
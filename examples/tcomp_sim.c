@@ -0,0 +1,150 @@
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "sensor/pcf8523.h"
+#include "sensor/pcf8523_tcomp.h"
+
+// Usage: tcomp_sim [days]
+// Feeds a simulated outdoor temperature trace (day/night swing plus sensor noise) to the
+// compensation loop against an in-process register file, and compares the time error of a crystal
+// with and without compensation.
+//
+// The run fails when the compensated error ever exceeds MAX_COMP_ERROR_MS_PER_DAY over the days
+// simulated, or ends above MAX_COMP_RATIO of the uncompensated error.
+
+#define DEFAULT_DAYS 7
+#define SAMPLE_PERIOD_MS 60000U
+
+// The residual comes from the curve mismatch below, about 80 ms per day with this trace
+#define MAX_COMP_ERROR_MS_PER_DAY 100.0
+#define MAX_COMP_RATIO 0.25
+
+// The simulated crystal is not exactly the nominal curve used by the loop
+#define CRYSTAL_TURNOVER_C 24.0
+#define CRYSTAL_PARABOLIC_PPB -34.0
+#define CRYSTAL_STATIC_PPB 0.0
+
+typedef struct {
+    uint8_t regs[PCF8523_REGISTER_COUNT];
+    uint32_t writes;
+} fake_pcf8523_t;
+
+static bool fake_read(void *ctx, uint8_t i2cAddress, uint8_t startReg, uint8_t *data, size_t len) {
+    fake_pcf8523_t *fake = ctx;
+    (void)i2cAddress;
+
+    for (size_t i = 0; i < len; i++)
+        data[i] = fake->regs[(startReg + i) % PCF8523_REGISTER_COUNT];
+
+    return true;
+}
+
+static bool fake_write(void *ctx, uint8_t i2cAddress, const uint8_t *frame, size_t frameLen) {
+    fake_pcf8523_t *fake = ctx;
+    (void)i2cAddress;
+
+    fake->writes++;
+    for (size_t i = 1; i < frameLen; i++)
+        fake->regs[(frame[0] + i - 1) % PCF8523_REGISTER_COUNT] = frame[i];
+
+    return true;
+}
+
+static const pcf8523_Transport_t fake_transport = {
+    .read = fake_read,
+    .write = fake_write,
+};
+
+static double trace_celsius(double hours) {
+    // -5 °C before dawn, 35 °C in the afternoon
+    return 15.0 + 20.0 * sin((hours - 9.0) * M_PI / 12.0);
+}
+
+static double sensor_noise(void) {
+    return ((double)rand() / RAND_MAX - 0.5) * 4.0;
+}
+
+static void log_write(void *ctx, const pcf8523_TcompRecord_t *record) {
+    uint32_t *printed = ctx;
+
+    if ((*printed)++ < 10)
+        printf("write %lu: %.1f C, %ld ppb, offset %d, %.3f ms compensated so far\n",
+               (unsigned long)record->writes, record->tempMilliC / 1000.0,
+               (long)record->deviationPpb, record->offset, (double)record->correctionNs / 1e6);
+}
+
+int main(int argc, char **argv) {
+    long days = argc > 1 ? atol(argv[1]) : DEFAULT_DAYS;
+    if (days <= 0)
+        days = DEFAULT_DAYS;
+
+    fake_pcf8523_t fake = {0};
+    pcf8523_t pcf8523;
+    if (!pcf8523_init_struct_transport(&pcf8523, &fake_transport, &fake, PCF8523_DEFAULT_ADDR,
+                                       true, false)) {
+        printf("Error initializating the struct\n");
+        return -1;
+    }
+
+    pcf8523_TcompConfig_t config;
+    pcf8523_tcomp_default_config(&config);
+
+    uint32_t printed = 0;
+    pcf8523_Tcomp_t tc;
+    if (!pcf8523_tcomp_init(&tc, &pcf8523, &config, log_write, &printed)) {
+        printf("Error initializating the compensation\n");
+        return -1;
+    }
+
+    srand(1);
+
+    double freeErrorMs = 0.0;
+    double compErrorMs = 0.0;
+    double maxCompErrorMs = 0.0;
+    uint32_t samples = (uint32_t)(days * 24 * 60 * 60 * 1000 / SAMPLE_PERIOD_MS);
+
+    for (uint32_t i = 0; i < samples; i++) {
+        uint32_t nowMs = i * SAMPLE_PERIOD_MS;
+        double hours = (double)nowMs / 3600000.0;
+        double celsius = trace_celsius(hours);
+
+        double sensed = celsius + sensor_noise();
+
+        if (!pcf8523_tcomp_update(&tc, (int32_t)(sensed * 1000.0), nowMs)) {
+            printf("Error updating the compensation\n");
+            return -1;
+        }
+
+        // Error gained over the next sample period, with the register as the loop left it
+        pcf8523_OffsetMode_t mode;
+        int8_t offset;
+        if (!pcf8523_read_offset(&pcf8523, &mode, &offset))
+            return -1;
+
+        double deviation = CRYSTAL_STATIC_PPB + CRYSTAL_PARABOLIC_PPB *
+                                                    (celsius - CRYSTAL_TURNOVER_C) *
+                                                    (celsius - CRYSTAL_TURNOVER_C);
+        double step = mode == PCF8523_OFFSET_EVERY_MIN ? PCF8523_TCOMP_STEP_MIN_PPB
+                                                       : PCF8523_TCOMP_STEP_2H_PPB;
+
+        freeErrorMs += deviation * SAMPLE_PERIOD_MS * 1e-9;
+        compErrorMs += (deviation + offset * step) * SAMPLE_PERIOD_MS * 1e-9;
+        if (fabs(compErrorMs) > maxCompErrorMs)
+            maxCompErrorMs = fabs(compErrorMs);
+    }
+
+    printf("%ld days, %lu samples\n", days, (unsigned long)samples);
+    printf("offset writes: %lu (%lu bus writes), deferred by the rate limit: %lu\n",
+           (unsigned long)tc.writes, (unsigned long)fake.writes, (unsigned long)tc.deferred);
+    printf("compensation applied: %.3f ms\n", (double)tc.correctionNs / 1e6);
+    printf("time error without compensation: %.3f ms\n", freeErrorMs);
+    printf("time error with compensation:    %.3f ms (max %.3f ms)\n", compErrorMs,
+           maxCompErrorMs);
+
+    bool ok = maxCompErrorMs <= MAX_COMP_ERROR_MS_PER_DAY * (double)days &&
+              fabs(compErrorMs) <= MAX_COMP_RATIO * fabs(freeErrorMs);
+    printf("%s\n", ok ? "OK" : "FAILED");
+
+    return ok ? 0 : -1;
+}
@@ -0,0 +1,214 @@
+#define _POSIX_C_SOURCE 199309L
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "sensor/pcf8523.h"
+#include "sensor/pcf8523_telemetry.h"
+
+// Usage: telemetry_decode <file|tty|->     (prints the records and the link statistics)
+//        telemetry_decode --bench [frames] (encodes and decodes in memory, with injected errors)
+//
+// The input is the byte stream written by pcf8523_telemetry, for example a file captured with
+// cat /dev/ttyUSB0 > telemetry.bin or the serial port itself (set it to raw mode with stty first).
+
+#define READ_CHUNK 65536
+#define DEFAULT_BENCH_FRAMES 200000
+
+typedef struct {
+    bool print;
+    uint32_t times;
+    uint32_t snapshots;
+    uint32_t events;
+    uint32_t unknown;
+    uint64_t checksum; // Keeps the bench from dropping the work
+} decode_stats_t;
+
+static double now_s(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static void on_record(void *ctx, const pcf8523_TelemetryRecord_t *record) {
+    decode_stats_t *stats = ctx;
+    uint32_t clockUs;
+
+    switch (record->type) {
+        case PCF8523_TELEMETRY_TIME: {
+            uint32_t epoch;
+            uint16_t health;
+            if (!pcf8523_telemetry_parse_time(record, &epoch, &clockUs, &health))
+                break;
+            stats->times++;
+            stats->checksum += epoch + clockUs;
+            if (stats->print)
+                printf("%5u time  %10lu us epoch %lu health 0x%03x\n", record->frameSeq,
+                       (unsigned long)clockUs, (unsigned long)epoch, health);
+            return;
+        }
+
+        case PCF8523_TELEMETRY_REGISTERS: {
+            uint8_t regs[PCF8523_REGISTER_COUNT];
+            if (!pcf8523_telemetry_parse_registers(record, &clockUs, regs))
+                break;
+            stats->snapshots++;
+            stats->checksum += regs[PCF8523_SECONDS_REG];
+            if (stats->print) {
+                printf("%5u regs  %10lu us", record->frameSeq, (unsigned long)clockUs);
+                for (uint8_t i = 0; i < PCF8523_REGISTER_COUNT; i++)
+                    printf(" %02x", regs[i]);
+                printf("\n");
+            }
+            return;
+        }
+
+        case PCF8523_TELEMETRY_EVENT: {
+            uint16_t code;
+            uint32_t arg;
+            if (!pcf8523_telemetry_parse_event(record, &clockUs, &code, &arg))
+                break;
+            stats->events++;
+            stats->checksum += code + arg;
+            if (stats->print)
+                printf("%5u event %10lu us code %u arg %lu\n", record->frameSeq,
+                       (unsigned long)clockUs, code, (unsigned long)arg);
+            return;
+        }
+
+        default:
+            break;
+    }
+
+    stats->unknown++;
+}
+
+static void print_link(const pcf8523_TelemetryDecoder_t *dec, const decode_stats_t *stats) {
+    printf("frames %lu, records %lu (time %lu, registers %lu, events %lu, unknown %lu)\n",
+           (unsigned long)dec->frames, (unsigned long)dec->records, (unsigned long)stats->times,
+           (unsigned long)stats->snapshots, (unsigned long)stats->events,
+           (unsigned long)stats->unknown);
+    printf("crc errors %lu, malformed %lu, lost frames %lu\n", (unsigned long)dec->crcErrors,
+           (unsigned long)dec->malformed, (unsigned long)dec->lostFrames);
+}
+
+static int decode_stream(const char *path) {
+    int fd = strcmp(path, "-") == 0 ? STDIN_FILENO : open(path, O_RDONLY);
+    if (fd < 0) {
+        printf("Error opening %s\n", path);
+        return -1;
+    }
+
+    decode_stats_t stats = {.print = true};
+    pcf8523_TelemetryDecoder_t dec;
+    pcf8523_telemetry_decoder_init(&dec, on_record, &stats);
+
+    static uint8_t chunk[READ_CHUNK];
+    ssize_t n;
+    while ((n = read(fd, chunk, sizeof(chunk))) > 0)
+        pcf8523_telemetry_decode(&dec, chunk, (size_t)n);
+
+    if (fd != STDIN_FILENO)
+        close(fd);
+
+    print_link(&dec, &stats);
+
+    return 0;
+}
+
+typedef struct {
+    uint8_t *data;
+    size_t len;
+    size_t capacity;
+} memory_sink_t;
+
+static void sink_memory(void *ctx, const uint8_t *data, size_t len) {
+    memory_sink_t *sink = ctx;
+
+    if (sink->len + len > sink->capacity)
+        return;
+
+    memcpy(&sink->data[sink->len], data, len);
+    sink->len += len;
+}
+
+static int bench(long frames) {
+    memory_sink_t sink = {
+        .capacity = (size_t)frames * PCF8523_TELEMETRY_MAX_ENCODED,
+    };
+    sink.data = malloc(sink.capacity);
+    if (!sink.data) {
+        printf("Out of memory\n");
+        return -1;
+    }
+
+    pcf8523_TelemetryEncoder_t enc;
+    pcf8523_telemetry_encoder_init(&enc, sink_memory, &sink);
+
+    // A device sampling the time every 10 ms, the registers every second and an event now and then
+    uint8_t regs[4 + PCF8523_REGISTER_COUNT] = {0};
+    uint32_t clockUs = 0;
+    double start = now_s();
+    while (enc.frames < (uint32_t)frames) {
+        clockUs += 10000;
+        pcf8523_telemetry_add_time(&enc, 1700000000 + clockUs / 1000000, clockUs, 0);
+        if (clockUs % 1000000 == 0) {
+            regs[4 + PCF8523_SECONDS_REG] = (uint8_t)(clockUs / 1000000 % 60);
+            pcf8523_telemetry_add(&enc, PCF8523_TELEMETRY_REGISTERS, regs, sizeof(regs));
+        }
+        if (clockUs % 370000 == 0)
+            pcf8523_telemetry_add_event(&enc, clockUs, 7, clockUs / 1000);
+    }
+    pcf8523_telemetry_flush(&enc);
+    double encodeS = now_s() - start;
+
+    // Line noise: a flipped byte every 100 kB and a dropped 300 byte block
+    size_t len = sink.len;
+    for (size_t i = 50000; i < len; i += 100000)
+        sink.data[i] ^= 0x5A;
+    size_t cut = len / 2;
+    memmove(&sink.data[cut], &sink.data[cut + 300], len - cut - 300);
+    len -= 300;
+
+    decode_stats_t stats = {0};
+    pcf8523_TelemetryDecoder_t dec;
+    pcf8523_telemetry_decoder_init(&dec, on_record, &stats);
+
+    // Fed in uneven chunks, the way a serial port delivers the data
+    start = now_s();
+    for (size_t pos = 0; pos < len;) {
+        size_t n = 1 + (pos * 7919) % 4093;
+        if (n > len - pos)
+            n = len - pos;
+        pcf8523_telemetry_decode(&dec, &sink.data[pos], n);
+        pos += n;
+    }
+    double decodeS = now_s() - start;
+
+    printf("encoded %lu records in %lu frames, %zu bytes (%.2f bytes/record)\n",
+           (unsigned long)enc.records, (unsigned long)enc.frames, sink.len,
+           (double)sink.len / enc.records);
+    printf("encode %.1f MB/s, decode %.1f MB/s (%.1f M records/s)\n",
+           (double)sink.len / encodeS / 1e6, (double)len / decodeS / 1e6,
+           (double)dec.records / decodeS / 1e6);
+    print_link(&dec, &stats);
+
+    free(sink.data);
+
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    if (argc >= 2 && strcmp(argv[1], "--bench") == 0)
+        return bench(argc > 2 && atol(argv[2]) > 0 ? atol(argv[2]) : DEFAULT_BENCH_FRAMES);
+
+    if (argc != 2) {
+        printf("Usage: %s <file|tty|-> | --bench [frames]\n", argv[0]);
+        return -1;
+    }
+
+    return decode_stream(argv[1]);
+}
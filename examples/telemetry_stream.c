@@ -0,0 +1,69 @@
+#include "pico/stdlib.h"
+
+#include "hardware/i2c.h"
+#include "hardware/uart.h"
+#include "sensor/pcf8523.h"
+#include "sensor/pcf8523_telemetry.h"
+
+// Streams binary telemetry over UART0 (GPIO 0/1, 921600 baud): a time sample every 10 ms, a
+// register snapshot every second, one frame per 100 ms. Read it on the host with
+//   stty -F /dev/ttyUSB0 921600 raw && ./build/examples/telemetry_decode /dev/ttyUSB0
+// The UART is written directly, stdio would translate the 0x0A bytes inside the frames.
+
+#define I2C_BUS i2c0
+#define I2C_SDA 16
+#define I2C_SCL 17
+
+#define TELEMETRY_UART uart0
+#define TELEMETRY_TX 0
+#define TELEMETRY_RX 1
+#define TELEMETRY_BAUDRATE 921600
+
+#define BASE_CENTURY 2000
+
+#define SAMPLE_PERIOD_US 10000
+#define SAMPLES_PER_FRAME 10
+#define SAMPLES_PER_SNAPSHOT 100
+
+#define EVENT_READ_ERROR 1
+
+static void sink_uart(void *ctx, const uint8_t *data, size_t len) {
+    uart_write_blocking((uart_inst_t *)ctx, data, len);
+}
+
+int main(void) {
+    uart_init(TELEMETRY_UART, TELEMETRY_BAUDRATE);
+    gpio_set_function(TELEMETRY_TX, GPIO_FUNC_UART);
+    gpio_set_function(TELEMETRY_RX, GPIO_FUNC_UART);
+
+    i2c_init(I2C_BUS, 400000);
+    gpio_set_function(I2C_SDA, GPIO_FUNC_I2C);
+    gpio_set_function(I2C_SCL, GPIO_FUNC_I2C);
+    gpio_pull_up(I2C_SDA);
+    gpio_pull_up(I2C_SCL);
+
+    pcf8523_t pcf8523;
+    pcf8523_TelemetryEncoder_t enc;
+
+    pcf8523_init_struct(&pcf8523, I2C_BUS, PCF8523_DEFAULT_ADDR, true, false);
+    pcf8523_telemetry_encoder_init(&enc, sink_uart, TELEMETRY_UART);
+
+    uint32_t sample = 0;
+    absolute_time_t next = get_absolute_time();
+    while (true) {
+        uint32_t clockUs = time_us_32();
+
+        // Failures travel in the same stream as the samples
+        bool ok = sample % SAMPLES_PER_SNAPSHOT == 0
+                      ? pcf8523_telemetry_sample_registers(&enc, &pcf8523, clockUs)
+                      : pcf8523_telemetry_sample_time(&enc, &pcf8523, BASE_CENTURY, clockUs);
+        if (!ok)
+            pcf8523_telemetry_add_event(&enc, clockUs, EVENT_READ_ERROR, sample);
+
+        if (++sample % SAMPLES_PER_FRAME == 0)
+            pcf8523_telemetry_flush(&enc);
+
+        next = delayed_by_us(next, SAMPLE_PERIOD_US);
+        sleep_until(next);
+    }
+}
@@ -0,0 +1,317 @@
+#define _DEFAULT_SOURCE
+#define _XOPEN_SOURCE 600
+#include <fcntl.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "sensor/pcf8523.h"
+#include "sensor/pcf8523_iso.h"
+#include "sensor/pcf8523_sync.h"
+#include "sensor/pcf8523_telemetry.h"
+
+// Usage: time_sync <tty>            answers the sync rounds of a device and prints its report
+//        time_sync --sim [rounds]   the same against a simulated device on a pseudo-terminal
+//
+// The host clock (CLOCK_REALTIME) is the reference, so it should be disciplined by NTP or PTP.
+// Set the baudrate of a real port first, for example stty -F /dev/ttyACM0 921600.
+//
+// The simulated device runs the pcf8523_sync rounds with a clock of its own and injects up to
+// SIM_JITTER_US of one-sided delay into half of the transfers, the way USB polling and task
+// scheduling do. Since it knows the real relation between its clock and the host clock, it prints
+// the error of the estimated offset after the first round and after the filter.
+
+#define READ_CHUNK 4096
+
+#define SIM_BOOT_US 5000000ULL // Device clock at the start of the simulation
+#define SIM_JITTER_US 3000
+#define SIM_SPIN_US 200 // The wait for the boundary busy loops the last part
+
+typedef struct {
+    int fd;
+    pcf8523_TelemetryEncoder_t enc;
+    uint64_t receiveUs;
+    uint32_t answered;
+    bool done;
+} host_t;
+
+static uint64_t clock_us(clockid_t clock) {
+    struct timespec ts;
+    clock_gettime(clock, &ts);
+    return (uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)ts.tv_nsec / 1000ULL;
+}
+
+static void sleep_us(uint64_t us) {
+    struct timespec ts = {.tv_sec = (time_t)(us / 1000000ULL),
+                          .tv_nsec = (long)(us % 1000000ULL) * 1000L};
+    nanosleep(&ts, NULL);
+}
+
+static void sink_fd(void *ctx, const uint8_t *data, size_t len) {
+    int fd = *(int *)ctx;
+
+    while (len > 0) {
+        ssize_t n = write(fd, data, len);
+        if (n <= 0)
+            return;
+        data += n;
+        len -= (size_t)n;
+    }
+}
+
+static bool set_raw(int fd) {
+    struct termios tio;
+
+    if (tcgetattr(fd, &tio) != 0)
+        return false;
+
+    cfmakeraw(&tio);
+    tio.c_cc[VMIN] = 1;
+    tio.c_cc[VTIME] = 0;
+
+    return tcsetattr(fd, TCSANOW, &tio) == 0;
+}
+
+static void print_report(const pcf8523_SyncReport_t *report, uint32_t answered) {
+    char iso[PCF8523_ISO_MAX_LEN];
+    pcf8523_IsoOptions_t utc = {.offsetMin = PCF8523_ISO_UTC};
+
+    pcf8523_iso_format_epoch(report->epoch, &utc, iso, sizeof(iso));
+
+    printf("RTC set to %s on the host second boundary\n", iso);
+    printf("rounds %u (answered here %lu), offset host - device %lld us\n", report->rounds,
+           (unsigned long)answered, (long long)report->offsetUs);
+    printf("link delay %lu us (worst %lu us), offset uncertainty +-%lu us\n",
+           (unsigned long)report->delayUs, (unsigned long)report->maxDelayUs,
+           (unsigned long)(report->delayUs / 2));
+    if (report->uncertaintyUs == UINT32_MAX)
+        printf("RTC edge error not measured\n");
+    else
+        printf("RTC edge error %ld us +-%lu us\n", (long)report->errorUs,
+               (unsigned long)report->uncertaintyUs);
+}
+
+static void on_host_record(void *ctx, const pcf8523_TelemetryRecord_t *record) {
+    host_t *host = ctx;
+    uint8_t round;
+    uint64_t requestUs;
+    pcf8523_SyncReport_t report;
+
+    if (pcf8523_sync_parse_request(record, &round, &requestUs)) {
+        pcf8523_sync_send_response(&host->enc, round, requestUs, host->receiveUs,
+                                   clock_us(CLOCK_REALTIME));
+        host->answered++;
+    }
+    else if (pcf8523_sync_parse_report(record, &report)) {
+        print_report(&report, host->answered);
+        host->done = true;
+    }
+}
+
+static int serve(int fd) {
+    host_t host = {.fd = fd};
+    pcf8523_TelemetryDecoder_t dec;
+    uint8_t chunk[READ_CHUNK];
+
+    pcf8523_telemetry_encoder_init(&host.enc, sink_fd, &host.fd);
+    pcf8523_telemetry_decoder_init(&dec, on_host_record, &host);
+
+    while (!host.done) {
+        ssize_t n = read(fd, chunk, sizeof(chunk));
+        // t2 is taken as soon as the bytes are in, before any decoding
+        host.receiveUs = clock_us(CLOCK_REALTIME);
+        if (n <= 0) {
+            printf("Link closed before the report\n");
+            return -1;
+        }
+
+        pcf8523_telemetry_decode(&dec, chunk, (size_t)n);
+    }
+
+    if (dec.crcErrors || dec.malformed)
+        printf("crc errors %lu, malformed %lu\n", (unsigned long)dec.crcErrors,
+               (unsigned long)dec.malformed);
+
+    return 0;
+}
+
+typedef struct {
+    uint64_t startUs; // CLOCK_MONOTONIC at device clock SIM_BOOT_US
+    pcf8523_Sync_t sync;
+    uint64_t receiveUs;
+} sim_device_t;
+
+static uint64_t sim_clock(const sim_device_t *sim) {
+    return clock_us(CLOCK_MONOTONIC) - sim->startUs + SIM_BOOT_US;
+}
+
+// Host clock minus device clock, from the closest of a few back to back readings
+static int64_t sim_true_offset(const sim_device_t *sim) {
+    int64_t best = 0;
+    uint64_t bestGap = UINT64_MAX;
+
+    for (int i = 0; i < 16; i++) {
+        uint64_t before = sim_clock(sim);
+        uint64_t host = clock_us(CLOCK_REALTIME);
+        uint64_t after = sim_clock(sim);
+
+        if (after - before < bestGap) {
+            bestGap = after - before;
+            best = (int64_t)host - (int64_t)((before + after) / 2);
+        }
+    }
+
+    return best;
+}
+
+static void sim_jitter(void) {
+    if (rand() % 2)
+        sleep_us((uint64_t)(rand() % SIM_JITTER_US));
+}
+
+static void on_sim_record(void *ctx, const pcf8523_TelemetryRecord_t *record) {
+    sim_device_t *sim = ctx;
+
+    pcf8523_sync_handle(&sim->sync, record, sim->receiveUs);
+}
+
+static int run_sim_device(int fd, uint8_t rounds) {
+    sim_device_t sim = {.startUs = clock_us(CLOCK_MONOTONIC)};
+    pcf8523_TelemetryEncoder_t enc;
+    pcf8523_TelemetryDecoder_t dec;
+    uint8_t chunk[READ_CHUNK];
+    int64_t firstOffset = 0;
+
+    srand((unsigned)sim.startUs);
+    pcf8523_sync_init(&sim.sync);
+    pcf8523_telemetry_encoder_init(&enc, sink_fd, &fd);
+    pcf8523_telemetry_decoder_init(&dec, on_sim_record, &sim);
+
+    for (uint8_t i = 0; i < rounds; i++) {
+        uint64_t requestUs = sim_clock(&sim);
+        sim_jitter();
+        pcf8523_sync_request(&sim.sync, &enc, requestUs);
+
+        uint64_t deadline = requestUs + PCF8523_SYNC_ROUND_TIMEOUT_US;
+        while (sim.sync.pending && sim_clock(&sim) < deadline) {
+            struct pollfd pfd = {.fd = fd, .events = POLLIN};
+            if (poll(&pfd, 1, 1) <= 0)
+                continue;
+
+            ssize_t n = read(fd, chunk, sizeof(chunk));
+            sim_jitter();
+            sim.receiveUs = sim_clock(&sim);
+            if (n > 0)
+                pcf8523_telemetry_decode(&dec, chunk, (size_t)n);
+        }
+        sim.sync.pending = false;
+
+        if (i == 0)
+            firstOffset = sim.sync.offsetUs;
+    }
+
+    uint64_t boundaryUs;
+    uint32_t epoch;
+    if (!pcf8523_sync_next_boundary(&sim.sync, sim_clock(&sim), PCF8523_SYNC_SET_LEAD_US,
+                                    &boundaryUs, &epoch)) {
+        printf("device: no round answered\n");
+        return -1;
+    }
+
+    // The simulated RTC is set when the device clock reaches the boundary
+    uint64_t now = sim_clock(&sim);
+    if (boundaryUs > now + SIM_SPIN_US)
+        sleep_us(boundaryUs - now - SIM_SPIN_US);
+    while ((now = sim_clock(&sim)) < boundaryUs)
+        ;
+    int64_t setErrorUs = (int64_t)clock_us(CLOCK_REALTIME) - (int64_t)epoch * 1000000LL;
+
+    int64_t trueOffset = sim_true_offset(&sim);
+    printf("device: offset error after the first round %lld us, after %u rounds %lld us\n",
+           (long long)(firstOffset - trueOffset), sim.sync.rounds,
+           (long long)(sim.sync.offsetUs - trueOffset));
+    printf("device: simulated RTC set %lld us off the host second\n", (long long)setErrorUs);
+    fflush(stdout);
+
+    pcf8523_SyncReport_t report = {
+        .epoch = epoch,
+        .offsetUs = sim.sync.offsetUs,
+        .delayUs = sim.sync.delayUs,
+        .maxDelayUs = sim.sync.maxDelayUs,
+        .rounds = sim.sync.rounds,
+        .errorUs = (int32_t)(now - boundaryUs),
+        .uncertaintyUs = 0,
+    };
+
+    return pcf8523_sync_send_report(&enc, &report) ? 0 : -1;
+}
+
+static int simulate(uint8_t rounds) {
+    int master = posix_openpt(O_RDWR | O_NOCTTY);
+    if (master < 0 || grantpt(master) != 0 || unlockpt(master) != 0) {
+        printf("Error creating the pseudo-terminal\n");
+        return -1;
+    }
+
+    int slave = open(ptsname(master), O_RDWR | O_NOCTTY);
+    if (slave < 0 || !set_raw(slave)) {
+        printf("Error opening the pseudo-terminal\n");
+        return -1;
+    }
+
+    fflush(stdout);
+    pid_t pid = fork();
+    if (pid < 0) {
+        printf("Error starting the simulated device\n");
+        return -1;
+    }
+
+    if (pid == 0) {
+        close(master);
+        int rc = run_sim_device(slave, rounds);
+        // Let the host read the report before the terminal goes away
+        sleep_us(100000);
+        _exit(rc == 0 ? 0 : 1);
+    }
+
+    close(slave);
+    int rc = serve(master);
+
+    int status;
+    waitpid(pid, &status, 0);
+    close(master);
+
+    return rc == 0 && WIFEXITED(status) && WEXITSTATUS(status) == 0 ? 0 : -1;
+}
+
+int main(int argc, char **argv) {
+    if (argc >= 2 && strcmp(argv[1], "--sim") == 0) {
+        int rounds = argc > 2 ? atoi(argv[2]) : PCF8523_SYNC_DEFAULT_ROUNDS;
+        if (rounds < 1 || rounds > UINT8_MAX) {
+            printf("Rounds must be between 1 and %d\n", UINT8_MAX);
+            return -1;
+        }
+        return simulate((uint8_t)rounds);
+    }
+
+    if (argc != 2) {
+        printf("Usage: %s <tty> | --sim [rounds]\n", argv[0]);
+        return -1;
+    }
+
+    int fd = open(argv[1], O_RDWR | O_NOCTTY);
+    if (fd < 0 || !set_raw(fd)) {
+        printf("Error opening %s\n", argv[1]);
+        return -1;
+    }
+
+    int rc = serve(fd);
+    close(fd);
+
+    return rc;
+}
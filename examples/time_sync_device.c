@@ -0,0 +1,80 @@
+#include "pico/stdlib.h"
+#include <stdio.h>
+
+#include "hardware/i2c.h"
+#include "hardware/uart.h"
+#include "sensor/pcf8523.h"
+#include "sensor/pcf8523_precise.h"
+#include "sensor/pcf8523_sync.h"
+#include "sensor/pcf8523_telemetry.h"
+
+// Sets the RTC from the host over UART0 (GPIO 0/1) at boot and then every hour. On the host:
+//   stty -F /dev/ttyUSB0 921600 && ./build/examples/time_sync /dev/ttyUSB0
+// The results go to the USB stdio, the UART only carries the binary frames.
+
+#define I2C_BUS i2c0
+#define I2C_SDA 16
+#define I2C_SCL 17
+
+#define SYNC_UART uart0
+#define SYNC_TX 0
+#define SYNC_RX 1
+#define SYNC_BAUDRATE 921600
+
+#define SYNC_PERIOD_MS (60 * 60 * 1000)
+#define RETRY_PERIOD_MS 5000
+
+static void sink_uart(void *ctx, const uint8_t *data, size_t len) {
+    uart_write_blocking((uart_inst_t *)ctx, data, len);
+}
+
+static size_t source_uart(void *ctx, uint8_t *data, size_t len) {
+    uart_inst_t *uart = (uart_inst_t *)ctx;
+    size_t n = 0;
+
+    while (n < len && uart_is_readable(uart))
+        data[n++] = (uint8_t)uart_getc(uart);
+
+    return n;
+}
+
+int main(void) {
+    stdio_init_all();
+
+    uart_init(SYNC_UART, SYNC_BAUDRATE);
+    gpio_set_function(SYNC_TX, GPIO_FUNC_UART);
+    gpio_set_function(SYNC_RX, GPIO_FUNC_UART);
+
+    i2c_init(I2C_BUS, 400000);
+    gpio_set_function(I2C_SDA, GPIO_FUNC_I2C);
+    gpio_set_function(I2C_SCL, GPIO_FUNC_I2C);
+    gpio_pull_up(I2C_SDA);
+    gpio_pull_up(I2C_SCL);
+
+    pcf8523_t pcf8523;
+    pcf8523_TelemetryEncoder_t enc;
+    pcf8523_Sync_t sync;
+    pcf8523_SyncReport_t report;
+
+    pcf8523_init_struct(&pcf8523, I2C_BUS, PCF8523_DEFAULT_ADDR, true, false);
+    pcf8523_telemetry_encoder_init(&enc, sink_uart, SYNC_UART);
+
+    while (true) {
+        if (!pcf8523_sync_run(&sync, &pcf8523, &enc, source_uart, SYNC_UART,
+                              PCF8523_SYNC_DEFAULT_ROUNDS, &report)) {
+            printf("Sync failed (%u rounds answered)\n", sync.rounds);
+            sleep_ms(RETRY_PERIOD_MS);
+            continue;
+        }
+
+        printf("RTC set to %lu, delay %lu us (worst %lu us)", (unsigned long)report.epoch,
+               (unsigned long)report.delayUs, (unsigned long)report.maxDelayUs);
+        if (report.uncertaintyUs == PCF8523_PRECISE_UNKNOWN_US)
+            printf(", edge error not measured\n");
+        else
+            printf(", edge error %ld us +-%lu us\n", (long)report.errorUs,
+                   (unsigned long)report.uncertaintyUs);
+
+        sleep_ms(SYNC_PERIOD_MS);
+    }
+}
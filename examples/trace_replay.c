@@ -0,0 +1,430 @@
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "sensor/pcf8523.h"
+#include "sensor/pcf8523_trace.h"
+
+// Usage: trace_replay list <trace>          (decoded records)
+//        trace_replay replay <trace> [out]  (runs the records through the driver on a stand-in bus)
+//        trace_replay compare <trace> <trace>
+//        trace_replay record <out>          (a reference session against an in-process device)
+//
+// A trace is the output of pcf8523_trace_dump, for example captured from the UART with
+// cat /dev/ttyUSB0 > trace.bin. Text printed before the trace header is skipped.
+
+#define MAX_TRACE_SIZE (16 * 1024 * 1024)
+
+typedef struct {
+    uint8_t *data;
+    size_t len;
+    size_t first; // Offset of the first record
+    uint32_t records;
+    uint32_t dropped;
+} trace_file_t;
+
+typedef struct {
+    uint32_t reads;
+    uint32_t writes;
+    uint32_t failures;
+    uint32_t bytes;
+    uint64_t busyUs;
+    uint16_t maxUs;
+    uint32_t spanUs; // From the first to the last record
+} trace_stats_t;
+
+// Stand-in bus serving the recorded transfers in order and checking that the driver asks for them
+typedef struct {
+    const trace_file_t *trace;
+    size_t pos;
+    uint32_t served;
+    uint32_t mismatches;
+} standin_bus_t;
+
+static bool load_trace(const char *path, trace_file_t *trace) {
+    FILE *file = fopen(path, "rb");
+    if (!file) {
+        printf("Error opening %s\n", path);
+        return false;
+    }
+
+    trace->data = malloc(MAX_TRACE_SIZE);
+    trace->len = trace->data ? fread(trace->data, 1, MAX_TRACE_SIZE, file) : 0;
+    fclose(file);
+
+    if (!pcf8523_trace_parse_header(trace->data, trace->len, &trace->first, &trace->records,
+                                    &trace->dropped)) {
+        printf("%s: no trace header\n", path);
+        return false;
+    }
+
+    return true;
+}
+
+static uint32_t host_clock_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)ts.tv_nsec / 1000ULL);
+}
+
+static void print_record(uint32_t index, const pcf8523_TraceRecord_t *record) {
+    printf("%6lu %10lu us %5u us 0x%02x %s 0x%02x %-4s", (unsigned long)index,
+           (unsigned long)record->timestampUs, record->durationUs, record->i2cAddress,
+           (record->flags & PCF8523_TRACE_FLAG_WRITE) ? "W" : "R", record->reg,
+           (record->flags & PCF8523_TRACE_FLAG_OK) ? "ok" : "FAIL");
+
+    for (uint8_t i = 0; i < record->len; i++)
+        printf(" %02x", record->payload[i]);
+    if (record->flags & PCF8523_TRACE_FLAG_TRUNCATED)
+        printf(" ...");
+    printf("\n");
+}
+
+static void collect_stats(const uint8_t *data, size_t len, size_t pos, trace_stats_t *stats) {
+    pcf8523_TraceRecord_t record;
+    uint32_t firstUs = 0;
+    bool first = true;
+
+    memset(stats, 0, sizeof(*stats));
+
+    while (pcf8523_trace_parse(data, len, &pos, &record)) {
+        if (record.flags & PCF8523_TRACE_FLAG_WRITE)
+            stats->writes++;
+        else
+            stats->reads++;
+        if (!(record.flags & PCF8523_TRACE_FLAG_OK))
+            stats->failures++;
+
+        stats->bytes += record.len;
+        stats->busyUs += record.durationUs;
+        if (record.durationUs > stats->maxUs)
+            stats->maxUs = record.durationUs;
+
+        if (first)
+            firstUs = record.timestampUs;
+        first = false;
+        stats->spanUs = record.timestampUs - firstUs;
+    }
+}
+
+static void print_stats(const char *name, const trace_stats_t *stats) {
+    uint32_t transfers = stats->reads + stats->writes;
+
+    printf("%-10s %8lu %8lu %8lu %8lu %10.1f %8u %12lu\n", name, (unsigned long)stats->reads,
+           (unsigned long)stats->writes, (unsigned long)stats->failures,
+           (unsigned long)stats->bytes,
+           transfers ? (double)stats->busyUs / (double)transfers : 0.0, stats->maxUs,
+           (unsigned long)stats->spanUs);
+}
+
+static void print_stats_header(void) {
+    printf("%-10s %8s %8s %8s %8s %10s %8s %12s\n", "", "reads", "writes", "failed", "bytes",
+           "mean us", "max us", "span us");
+}
+
+static bool standin_next(standin_bus_t *bus, bool write, uint8_t i2cAddress, uint8_t reg,
+                         size_t len, pcf8523_TraceRecord_t *record) {
+    if (!pcf8523_trace_parse(bus->trace->data, bus->trace->len, &bus->pos, record)) {
+        printf("replay: transfer %lu is past the end of the trace\n", (unsigned long)bus->served);
+        bus->mismatches++;
+        return false;
+    }
+
+    bus->served++;
+
+    bool recordWrite = record->flags & PCF8523_TRACE_FLAG_WRITE;
+    bool truncated = record->flags & PCF8523_TRACE_FLAG_TRUNCATED;
+    if (recordWrite != write || record->i2cAddress != i2cAddress || record->reg != reg ||
+        (!truncated && record->len != len)) {
+        printf("replay: transfer %lu differs from the trace\n", (unsigned long)bus->served - 1);
+        bus->mismatches++;
+        return false;
+    }
+
+    return true;
+}
+
+static bool standin_read(void *ctx, uint8_t i2cAddress, uint8_t startReg, uint8_t *data,
+                         size_t len) {
+    standin_bus_t *bus = ctx;
+    pcf8523_TraceRecord_t record;
+
+    if (!standin_next(bus, false, i2cAddress, startReg, len, &record))
+        return false;
+
+    memset(data, 0, len);
+    memcpy(data, record.payload, record.len);
+
+    return record.flags & PCF8523_TRACE_FLAG_OK;
+}
+
+static bool standin_write(void *ctx, uint8_t i2cAddress, const uint8_t *frame, size_t frameLen) {
+    standin_bus_t *bus = ctx;
+    pcf8523_TraceRecord_t record;
+
+    if (!standin_next(bus, true, i2cAddress, frame[0], frameLen - 1, &record))
+        return false;
+
+    if (memcmp(&frame[1], record.payload, record.len) != 0) {
+        printf("replay: transfer %lu writes other data\n", (unsigned long)bus->served - 1);
+        bus->mismatches++;
+    }
+
+    return record.flags & PCF8523_TRACE_FLAG_OK;
+}
+
+static const pcf8523_Transport_t standin_transport = {
+    .read = standin_read,
+    .write = standin_write,
+};
+
+typedef struct {
+    uint8_t *data;
+    size_t len;
+} memory_sink_t;
+
+static void sink_file(void *ctx, const uint8_t *data, size_t len) {
+    fwrite(data, 1, len, (FILE *)ctx);
+}
+
+static void sink_memory(void *ctx, const uint8_t *data, size_t len) {
+    memory_sink_t *sink = ctx;
+    uint8_t *grown = realloc(sink->data, sink->len + len);
+
+    if (!grown)
+        return;
+
+    memcpy(&grown[sink->len], data, len);
+    sink->data = grown;
+    sink->len += len;
+}
+
+typedef struct {
+    uint8_t regs[PCF8523_REGISTER_COUNT];
+} fake_pcf8523_t;
+
+static bool fake_read(void *ctx, uint8_t i2cAddress, uint8_t startReg, uint8_t *data, size_t len) {
+    fake_pcf8523_t *fake = ctx;
+    (void)i2cAddress;
+
+    for (size_t i = 0; i < len; i++)
+        data[i] = fake->regs[(startReg + i) % PCF8523_REGISTER_COUNT];
+
+    return true;
+}
+
+static bool fake_write(void *ctx, uint8_t i2cAddress, const uint8_t *frame, size_t frameLen) {
+    fake_pcf8523_t *fake = ctx;
+    (void)i2cAddress;
+
+    for (size_t i = 1; i < frameLen; i++)
+        fake->regs[(frame[0] + i - 1) % PCF8523_REGISTER_COUNT] = frame[i];
+
+    return true;
+}
+
+static const pcf8523_Transport_t fake_transport = {
+    .read = fake_read,
+    .write = fake_write,
+};
+
+static int cmd_list(const trace_file_t *trace) {
+    pcf8523_TraceRecord_t record;
+    size_t pos = trace->first;
+    uint32_t index = 0;
+
+    printf("%lu records, %lu dropped before the capture\n", (unsigned long)trace->records,
+           (unsigned long)trace->dropped);
+
+    while (pcf8523_trace_parse(trace->data, trace->len, &pos, &record))
+        print_record(index++, &record);
+
+    return index == trace->records ? 0 : 1;
+}
+
+static int cmd_replay(const trace_file_t *trace, const char *outPath) {
+    standin_bus_t bus = {.trace = trace, .pos = trace->first};
+    pcf8523_t pcf8523;
+
+    if (!pcf8523_init_struct_transport(&pcf8523, &standin_transport, &bus, PCF8523_DEFAULT_ADDR,
+                                       true, false))
+        return 1;
+
+    // The replay is recorded too, so its counts and timings can be compared with the capture
+    size_t size = trace->len;
+    uint8_t *buffer = malloc(size);
+    pcf8523_Trace_t replay;
+    if (!buffer || !pcf8523_trace_init(&replay, &pcf8523, buffer, size, host_clock_us))
+        return 1;
+
+    pcf8523_TraceRecord_t record;
+    size_t pos = trace->first;
+    while (pcf8523_trace_parse(trace->data, trace->len, &pos, &record)) {
+        uint8_t frame[PCF8523_FRAME_SIZE(PCF8523_TRACE_MAX_PAYLOAD)];
+        pcf8523_Transaction_t tx;
+        bool write = record.flags & PCF8523_TRACE_FLAG_WRITE;
+
+        pcf8523.i2cAddress = record.i2cAddress;
+        if (!pcf8523_transaction_init(&tx, record.reg, frame, record.len, write))
+            return 1;
+        if (write)
+            memcpy(pcf8523_transaction_data(&tx), record.payload, record.len);
+
+        bool ok = pcf8523_execute(&pcf8523, &tx);
+        if (ok != ((record.flags & PCF8523_TRACE_FLAG_OK) != 0))
+            bus.mismatches++;
+
+        if (!write && ok && memcmp(pcf8523_transaction_data(&tx), record.payload, record.len))
+            bus.mismatches++;
+    }
+
+    if (outPath) {
+        FILE *out = fopen(outPath, "wb");
+        if (!out) {
+            printf("Error opening %s\n", outPath);
+            return 1;
+        }
+        pcf8523_trace_dump(&replay, sink_file, out);
+        fclose(out);
+    }
+
+    memory_sink_t replayed = {0};
+    pcf8523_trace_dump(&replay, sink_memory, &replayed);
+
+    trace_stats_t capturedStats;
+    trace_stats_t replayedStats;
+    size_t replayedFirst;
+    collect_stats(trace->data, trace->len, trace->first, &capturedStats);
+    if (!pcf8523_trace_parse_header(replayed.data, replayed.len, &replayedFirst, NULL, NULL))
+        return 1;
+    collect_stats(replayed.data, replayed.len, replayedFirst, &replayedStats);
+
+    print_stats_header();
+    print_stats("captured", &capturedStats);
+    print_stats("replayed", &replayedStats);
+    printf("%lu transfers served, %lu mismatches\n", (unsigned long)bus.served,
+           (unsigned long)bus.mismatches);
+
+    free(replayed.data);
+    free(buffer);
+
+    return bus.mismatches == 0 ? 0 : 1;
+}
+
+static int cmd_compare(const trace_file_t *a, const trace_file_t *b) {
+    trace_stats_t statsA;
+    trace_stats_t statsB;
+
+    collect_stats(a->data, a->len, a->first, &statsA);
+    collect_stats(b->data, b->len, b->first, &statsB);
+
+    print_stats_header();
+    print_stats("first", &statsA);
+    print_stats("second", &statsB);
+
+    // Transfers per start register and direction
+    uint32_t counts[2][2][256] = {0};
+    const trace_file_t *traces[2] = {a, b};
+    for (int t = 0; t < 2; t++) {
+        pcf8523_TraceRecord_t record;
+        size_t pos = traces[t]->first;
+        while (pcf8523_trace_parse(traces[t]->data, traces[t]->len, &pos, &record))
+            counts[t][(record.flags & PCF8523_TRACE_FLAG_WRITE) ? 1 : 0][record.reg]++;
+    }
+
+    printf("\n%-10s %8s %8s\n", "register", "first", "second");
+    for (int dir = 0; dir < 2; dir++) {
+        for (int reg = 0; reg < 256; reg++) {
+            if (counts[0][dir][reg] == 0 && counts[1][dir][reg] == 0)
+                continue;
+            printf("%s 0x%02x %*s %8lu %8lu%s\n", dir ? "W" : "R", reg, 3, "",
+                   (unsigned long)counts[0][dir][reg], (unsigned long)counts[1][dir][reg],
+                   counts[0][dir][reg] != counts[1][dir][reg] ? "  *" : "");
+        }
+    }
+
+    return 0;
+}
+
+static int cmd_record(const char *outPath) {
+    static uint8_t buffer[4096];
+    fake_pcf8523_t fake = {0};
+    pcf8523_t pcf8523;
+    pcf8523_Trace_t trace;
+
+    if (!pcf8523_init_struct_transport(&pcf8523, &fake_transport, &fake, PCF8523_DEFAULT_ADDR,
+                                       true, false))
+        return 1;
+    if (!pcf8523_trace_init(&trace, &pcf8523, buffer, sizeof(buffer), host_clock_us))
+        return 1;
+
+    pcf8523_Datetime_t datetime = {
+        .sec = 0,
+        .min = 0,
+        .hour = 12,
+        .hourMode = PCF8523_HOUR_MODE_24H,
+        .day = 1,
+        .weekDay = 6,
+        .month = 1,
+        .year = 0,
+    };
+
+    bool ok = pcf8523_set_hour_mode(&pcf8523, false) &&
+              pcf8523_set_datetime(&pcf8523, &datetime) &&
+              pcf8523_enable_interrupt_source(&pcf8523, PCF8523_CTRL1_REG,
+                                              PCF8523_CTRL1_ENABLE_SECOND_INT_MASK, true);
+    for (int i = 0; ok && i < 10; i++)
+        ok = pcf8523_read_datetime(&pcf8523, &datetime);
+
+    if (!ok) {
+        printf("Error running the session\n");
+        return 1;
+    }
+
+    FILE *out = fopen(outPath, "wb");
+    if (!out) {
+        printf("Error opening %s\n", outPath);
+        return 1;
+    }
+    pcf8523_trace_dump(&trace, sink_file, out);
+    fclose(out);
+
+    printf("%lu records written to %s\n", (unsigned long)trace.records, outPath);
+
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    if (argc < 3) {
+        printf("Usage: %s list <trace>\n", argv[0]);
+        printf("       %s replay <trace> [replayed trace]\n", argv[0]);
+        printf("       %s compare <trace> <trace>\n", argv[0]);
+        printf("       %s record <trace>\n", argv[0]);
+        return -1;
+    }
+
+    if (strcmp(argv[1], "record") == 0)
+        return cmd_record(argv[2]);
+
+    trace_file_t first = {0};
+    if (!load_trace(argv[2], &first))
+        return -1;
+
+    if (strcmp(argv[1], "list") == 0)
+        return cmd_list(&first);
+
+    if (strcmp(argv[1], "replay") == 0)
+        return cmd_replay(&first, argc > 3 ? argv[3] : NULL);
+
+    if (strcmp(argv[1], "compare") == 0 && argc > 3) {
+        trace_file_t second = {0};
+        if (!load_trace(argv[3], &second))
+            return -1;
+        return cmd_compare(&first, &second);
+    }
+
+    printf("Unknown command %s\n", argv[1]);
+    return -1;
+}
@@ -0,0 +1,217 @@
+#ifdef PCF8523_HOST_BUILD
+#define _POSIX_C_SOURCE 199309L
+#include <time.h>
+#else
+#include "pico/stdlib.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "sensor/pcf8523.h"
+#include "sensor/pcf8523_tstream.h"
+
+// Timestamp stream encode and decode throughput, with a round trip and a seek check, on the host
+// and on the Pico. The samples come from a seeded generator, so the decoded epochs are compared
+// against a second run of it instead of a stored copy.
+
+#ifdef PCF8523_HOST_BUILD
+#define STREAM_SIZE (4u * 1024u * 1024u)
+#define DECODE_ROUNDS 20
+#else
+#define STREAM_SIZE (32u * 1024u)
+#define DECODE_ROUNDS 20
+#endif
+
+#define KEYFRAME_INTERVAL 256
+#define CHUNK 256
+#define SEEKS 1000
+
+#define FIRST_EPOCH 1700000000ULL
+
+typedef enum {
+    PROFILE_REGULAR, // One sample per second
+    PROFILE_JITTER,  // Every minute, one second early or late now and then
+    PROFILE_GAPS,    // Bursts with random gaps of up to a day
+} profile_t;
+
+typedef struct {
+    profile_t profile;
+    uint32_t rng;
+    uint64_t epoch;
+} series_t;
+
+static uint8_t stream[STREAM_SIZE];
+static uint64_t epochs[CHUNK];
+
+static double now_us(void) {
+#ifdef PCF8523_HOST_BUILD
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e6 + (double)ts.tv_nsec / 1e3;
+#else
+    return (double)time_us_64();
+#endif
+}
+
+static void series_init(series_t *series, profile_t profile) {
+    series->profile = profile;
+    series->rng = 0x5EED0001u + (uint32_t)profile;
+    series->epoch = FIRST_EPOCH;
+}
+
+static uint32_t series_random(series_t *series) {
+    // xorshift32
+    series->rng ^= series->rng << 13;
+    series->rng ^= series->rng >> 17;
+    series->rng ^= series->rng << 5;
+    return series->rng;
+}
+
+static uint64_t series_next(series_t *series) {
+    uint32_t r = series_random(series);
+
+    switch (series->profile) {
+    case PROFILE_REGULAR:
+        series->epoch += 1;
+        break;
+    case PROFILE_JITTER:
+        series->epoch += 60;
+        if ((r & 0x0F) == 0)
+            series->epoch += (r & 0x10) ? 1 : (uint64_t)-1;
+        break;
+    case PROFILE_GAPS:
+        series->epoch += (r & 0xFF) == 0 ? (r >> 8) % 86400 : 1 + (r >> 8) % 4;
+        break;
+    }
+
+    return series->epoch;
+}
+
+static const char *profile_name(profile_t profile) {
+    switch (profile) {
+    case PROFILE_REGULAR:
+        return "regular";
+    case PROFILE_JITTER:
+        return "jitter";
+    default:
+        return "gaps";
+    }
+}
+
+// Decodes the whole stream, compared against the generator if check is set
+static bool decode_all(size_t length, series_t *check, size_t *samples) {
+    pcf8523_TstreamDecoder_t dec;
+    size_t count;
+
+    *samples = 0;
+    if (!pcf8523_tstream_decoder_init(&dec, stream, length))
+        return false;
+
+    do {
+        if (!pcf8523_tstream_decode(&dec, epochs, CHUNK, &count))
+            return false;
+
+        if (check) {
+            for (size_t i = 0; i < count; i++) {
+                if (epochs[i] != series_next(check))
+                    return false;
+            }
+        }
+        *samples += count;
+    } while (count == CHUNK);
+
+    return true;
+}
+
+// Every target is found by seeking to its keyframe and decoding forward. The targets are spread
+// over the stream so the series is generated only once.
+static uint32_t check_seek(size_t length, profile_t profile, size_t samples) {
+    uint32_t errors = 0;
+    series_t series;
+    series_t picker;
+
+    series_init(&series, profile);
+    series_init(&picker, PROFILE_REGULAR);
+
+    size_t step = samples / SEEKS;
+    size_t s = 0;
+    for (uint32_t i = 0; i < SEEKS && step > 0; i++) {
+        size_t target = i * step + series_random(&picker) % step;
+
+        uint64_t epoch = 0;
+        while (s <= target) {
+            epoch = series_next(&series);
+            s++;
+        }
+
+        pcf8523_TstreamDecoder_t dec;
+        size_t count = 1;
+        uint64_t found = 0;
+        pcf8523_tstream_decoder_init(&dec, stream, length);
+        pcf8523_tstream_seek(&dec, epoch);
+
+        while (found < epoch && count == 1) {
+            if (!pcf8523_tstream_decode(&dec, &found, 1, &count))
+                break;
+        }
+        errors += found != epoch;
+    }
+
+    return errors;
+}
+
+int main(void) {
+#ifndef PCF8523_HOST_BUILD
+    stdio_init_all();
+    sleep_ms(2000);
+#endif
+
+    uint32_t errors = 0;
+
+    for (profile_t profile = PROFILE_REGULAR; profile <= PROFILE_GAPS; profile++) {
+        pcf8523_TstreamEncoder_t enc;
+        series_t series;
+        size_t written = 0;
+
+        pcf8523_tstream_encoder_init(&enc, stream, sizeof(stream), KEYFRAME_INTERVAL);
+        series_init(&series, profile);
+
+        double start = now_us();
+        while (pcf8523_tstream_encode(&enc, series_next(&series)))
+            written++;
+        double encodeUs = now_us() - start;
+
+        // Round trip, the series is replayed for the comparison
+        size_t samples;
+        series_init(&series, profile);
+        if (!decode_all(enc.length, &series, &samples) || samples != written) {
+            printf("%-8s round trip failed after %lu samples\n", profile_name(profile),
+                   (unsigned long)samples);
+            errors++;
+            continue;
+        }
+
+        // Best of the rounds, the others are disturbed by whatever else runs on the machine
+        double decodeUs = 0;
+        for (uint32_t i = 0; i < DECODE_ROUNDS; i++) {
+            start = now_us();
+            decode_all(enc.length, NULL, &samples);
+            double elapsed = now_us() - start;
+            if (i == 0 || elapsed < decodeUs)
+                decodeUs = elapsed;
+        }
+
+        uint32_t seekErrors = check_seek(enc.length, profile, samples);
+        errors += seekErrors;
+
+        printf("%-8s %8lu samples %5.2f B/sample, encode %7.1f MB/s, decode %7.1f MB/s "
+               "(%6.1f M samples/s), seek errors %lu\n",
+               profile_name(profile), (unsigned long)samples, (double)enc.length / (double)samples,
+               (double)enc.length / encodeUs, (double)enc.length / decodeUs,
+               (double)samples / decodeUs, (unsigned long)seekErrors);
+    }
+
+    return errors == 0 ? 0 : -1;
+}
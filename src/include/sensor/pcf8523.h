@@ -12,9 +12,41 @@
 #ifndef PCF8523_H
 #define PCF8523_H
 
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifndef PCF8523_HOST_BUILD
 #include "hardware/i2c.h"
+#endif
+
+// Build configuration, normally set from the CMake options of the same name
+#ifndef PCF8523_ENABLE_ALARM
+#define PCF8523_ENABLE_ALARM 1
+#endif
+
+#ifndef PCF8523_ENABLE_TIMER
+#define PCF8523_ENABLE_TIMER 1
+#endif
+
+#ifndef PCF8523_ENABLE_OFFSET
+#define PCF8523_ENABLE_OFFSET 1
+#endif
+
+#ifndef PCF8523_ENABLE_CLKOUT
+#define PCF8523_ENABLE_CLKOUT 1
+#endif
+
+#ifndef PCF8523_FIXED_HOUR_FORMAT
+#define PCF8523_FIXED_HOUR_FORMAT 0 // 0 (selected at runtime), 12 or 24
+#endif
+
+#ifndef PCF8523_SKIP_VALIDATION
+#define PCF8523_SKIP_VALIDATION 0
+#endif
 
 #define PCF8523_DEFAULT_ADDR 0x68
+#define PCF8523_REGISTER_COUNT 0x14
 
 typedef enum {
     PCF8523_CTRL1_REG = 0x00,
@@ -119,6 +151,23 @@ typedef enum {
     PCF8523_CTRL3_BATT_STATUS_INT_FLAG_MASK_RO = (1 << 2)     // BLF
 } pcf8523_InterruptFlag_t;
 
+// Status returned along with the time by pcf8523_read_datetime_health
+typedef enum {
+    PCF8523_HEALTH_OS = (1 << 0),   // Oscillator stopped, time not guaranteed
+    PCF8523_HEALTH_STOP = (1 << 1), // Time frozen with the STOP bit
+    PCF8523_HEALTH_BLF = (1 << 2),  // Battery low
+    PCF8523_HEALTH_BSF = (1 << 3),  // Switched over to the battery
+    PCF8523_HEALTH_AF = (1 << 4),   // Pending interrupt flags of CTRL2
+    PCF8523_HEALTH_SF = (1 << 5),
+    PCF8523_HEALTH_CTBF = (1 << 6),
+    PCF8523_HEALTH_CTAF = (1 << 7),
+    PCF8523_HEALTH_WTAF = (1 << 8)
+} pcf8523_Health_t;
+
+#define PCF8523_HEALTH_PENDING_MASK                                                                \
+    (PCF8523_HEALTH_WTAF | PCF8523_HEALTH_CTAF | PCF8523_HEALTH_CTBF | PCF8523_HEALTH_SF |         \
+     PCF8523_HEALTH_AF)
+
 // They are shifted 5 positions to be in place when written to the register
 typedef enum {
     PCF8523_PWR_SWITCH_OVER_STANDARD_LOW_DETECT_ENABLED = (0 << 5),
@@ -167,19 +216,70 @@ typedef struct {
     uint8_t year;
 } pcf8523_Datetime_t;
 
+// Register level bus access, reads must use a repeated start between the address and the data.
+// Writes get the whole frame (start register followed by the payload) so they need no copy.
+typedef struct {
+    bool (*read)(void *ctx, uint8_t i2cAddress, uint8_t startReg, uint8_t *data, size_t len);
+    bool (*write)(void *ctx, uint8_t i2cAddress, const uint8_t *frame, size_t frameLen);
+} pcf8523_Transport_t;
+
+// Caller owned buffer of PCF8523_FRAME_SIZE(len) bytes, frame[0] holds the start register and the
+// payload follows it. The same layout is streamed as is by the transports, and can be handed to a
+// DMA channel as one block per transaction.
+//
+// Descriptors are meant to be prepared once by callers that own their buffers. The driver's own
+// paths (pcf8523_read_datetime, pcf8523_set_datetime, ...) keep a frame on the stack instead of
+// one prepared in pcf8523_t: a shared frame would be overwritten by another task between the
+// transfer and the decode, since the transport wrappers (pcf8523_rtos.h) lock per transfer. The
+// datetime paths fill that frame in place and call the transport directly, without a descriptor.
+#define PCF8523_FRAME_SIZE(len) ((len) + 1)
+
+typedef struct {
+    uint8_t *frame;
+    uint8_t len; // Payload length
+    bool write;
+} pcf8523_Transaction_t;
+
 typedef struct {
+#ifndef PCF8523_HOST_BUILD
     i2c_inst_t *i2c;
+#endif
+    const pcf8523_Transport_t *transport;
+    void *transportCtx;
     uint8_t i2cAddress;
     bool format24h;
 } pcf8523_t;
 
+#ifndef PCF8523_HOST_BUILD
+extern const pcf8523_Transport_t pcf8523_pico_transport;
+
 bool pcf8523_init_struct(pcf8523_t *pcf8523, i2c_inst_t *i2c, uint8_t i2cAddress, bool is24hFormat,
                          bool checkFormat);
+#endif
+
+bool pcf8523_init_struct_transport(pcf8523_t *pcf8523, const pcf8523_Transport_t *transport,
+                                   void *transportCtx, uint8_t i2cAddress, bool is24hFormat,
+                                   bool checkFormat);
+
+bool pcf8523_transaction_init(pcf8523_Transaction_t *tx, uint8_t startReg, uint8_t *frame,
+                              size_t len, bool write);
+
+static inline uint8_t *pcf8523_transaction_data(const pcf8523_Transaction_t *tx) {
+    return &tx->frame[1];
+}
+
+bool pcf8523_execute(pcf8523_t *pcf8523, const pcf8523_Transaction_t *tx);
+
+bool pcf8523_execute_list(pcf8523_t *pcf8523, const pcf8523_Transaction_t *txs, size_t count);
 
 bool pcf8523_soft_reset(pcf8523_t *pcf8523);
 
 bool pcf8523_read_datetime(pcf8523_t *pcf8523, pcf8523_Datetime_t *datetime);
 
+// CTRL1..YEARS in one transfer, the time is decoded even with the OS flag set
+bool pcf8523_read_datetime_health(pcf8523_t *pcf8523, pcf8523_Datetime_t *datetime,
+                                  uint16_t *health);
+
 uint64_t pcf8523_datetime_to_epoch(const pcf8523_Datetime_t *dt, uint16_t century);
 
 pcf8523_Datetime_t epoch_to_pcf8523_datetime(uint64_t epoch);
@@ -192,6 +292,7 @@ bool pcf8523_set_datetime(pcf8523_t *pcf8523, pcf8523_Datetime_t *datetime);
 bool pcf8523_set_datetime_field(pcf8523_t *pcf8523, pcf8523_DatetimeReg_t reg, uint8_t value,
                                 pcf8523_HourMode_t *hourMode);
 
+#if PCF8523_ENABLE_ALARM
 bool pcf8523_read_alarm(pcf8523_t *pcf8523, pcf8523_Alarm_t *alarm);
 
 bool pcf8523_read_alarm_field(pcf8523_t *pcf8523, pcf8523_AlarmReg_t reg, uint8_t *value,
@@ -201,6 +302,7 @@ bool pcf8523_set_alarm(pcf8523_t *pcf8523, pcf8523_Alarm_t *alarm);
 
 bool pcf8523_set_alarm_field(pcf8523_t *pcf8523, pcf8523_AlarmReg_t reg, uint8_t value, bool enable,
                              pcf8523_HourMode_t *hourMode);
+#endif
 
 bool pcf8523_set_power_mode(pcf8523_t *pcf8523, pcf8523_PowerModes_t powerMode);
 
@@ -232,10 +334,13 @@ bool pcf8523_freeze_time(pcf8523_t *pcf8523, bool freeze);
 
 bool pcf8523_is_time_frozen(pcf8523_t *pcf8523, bool *frozen);
 
+#if PCF8523_ENABLE_OFFSET
 bool pcf8523_set_offset(pcf8523_t *pcf8523, pcf8523_OffsetMode_t mode, int8_t offset);
 
 bool pcf8523_read_offset(pcf8523_t *pcf8523, pcf8523_OffsetMode_t *mode, int8_t *offset);
+#endif
 
+#if PCF8523_ENABLE_TIMER
 bool pcf8523_set_timer_a_mode(pcf8523_t *pcf8523, pcf8523_TmrAMode_t mode);
 
 bool pcf8523_read_timer_a_mode(pcf8523_t *pcf8523, pcf8523_TmrAMode_t *mode);
@@ -257,7 +362,12 @@ bool pcf8523_set_timer_b_duration(pcf8523_t *pcf8523, pcf8523_TimerBValue *tmrB)
 
 bool pcf8523_read_timer_b_duration(pcf8523_t *pcf8523, pcf8523_TimerBValue *tmrB);
 
+uint64_t pcf8523_timer_duration_us(pcf8523_ClkSourceFreq_t sourceFreq, uint8_t value);
+#endif
+
+#if PCF8523_ENABLE_CLKOUT
 bool pcf8523_set_clk_out_mode(pcf8523_t *pcf8523, pcf8523_ClkOutFreq_t clkOutFreq);
 
 bool pcf8523_read_clk_out_mode(pcf8523_t *pcf8523, pcf8523_ClkSourceFreq_t *clkOutFreq);
 #endif
+#endif
@@ -0,0 +1,57 @@
+/**
+ * @file pcf8523_bus_tuner.h
+ * @brief I2C bus speed auto tuning up to Fast-mode Plus with verified fallback
+ *
+ * pcf8523_bus_tuner_probe steps the baudrate up with i2c_set_baudrate and checks every step by
+ * reading back a register image captured at 100 kHz (and, when Timer A is idle, by writing
+ * and reading back test patterns in the Timer A value register). The fastest step that passes is
+ * kept.
+ *
+ * The tuner wraps the transport of the pcf8523_t it is attached to, so at runtime it counts the
+ * failed transfers and drops one speed step (retrying the transfer) when the errors inside a
+ * window reach the threshold.
+ *
+ * The baudrate is a property of the whole I2C controller, so other devices on the same bus must
+ * support the selected speed too. Fast-mode Plus also needs stronger pull-ups than the internal
+ * ones.
+ *
+ * @author ljn0099
+ *
+ * @license MIT License
+ * Copyright (c) 2025 ljn0099
+ *
+ * See LICENSE file for details.
+ */
+#ifndef PCF8523_BUS_TUNER_H
+#define PCF8523_BUS_TUNER_H
+
+#include "sensor/pcf8523.h"
+
+#define PCF8523_BUS_TUNER_ERROR_WINDOW 64
+#define PCF8523_BUS_TUNER_PROBE_ROUNDS 8
+
+typedef struct {
+    pcf8523_t *pcf8523;
+    const pcf8523_Transport_t *transport; // Wrapped transport
+    void *transportCtx;
+
+    uint8_t level;
+    uint8_t maxLevel;
+    uint32_t baudrate;
+
+    uint32_t errorThreshold;
+    uint32_t windowTransfers;
+    uint32_t windowErrors;
+
+    uint32_t transfers;
+    uint32_t errors;
+    uint32_t fallbacks;
+} pcf8523_BusTuner_t;
+
+bool pcf8523_bus_tuner_init(pcf8523_BusTuner_t *tuner, pcf8523_t *pcf8523, uint32_t maxBaudrate,
+                            uint32_t errorThreshold);
+
+bool pcf8523_bus_tuner_probe(pcf8523_BusTuner_t *tuner);
+
+uint32_t pcf8523_bus_tuner_baudrate(const pcf8523_BusTuner_t *tuner);
+#endif
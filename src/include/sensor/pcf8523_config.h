@@ -0,0 +1,81 @@
+/**
+ * @file pcf8523_config.h
+ * @brief Declarative device configuration applied with a minimal diff of writes
+ *
+ * pcf8523_apply_config reads the control, offset and timer control registers in one burst, works
+ * out which of them differ from the profile and writes only those, coalescing neighbouring
+ * registers into one burst. Interrupt flags are preserved, STOP and the timer values are never
+ * touched. A warm boot with an unchanged profile costs one read and no writes.
+ *
+ * pcf8523_save_state / pcf8523_restore_state keep the whole register image instead, to bring the
+ * device back after pcf8523_soft_reset with one burst read and one burst write.
+ *
+ * @author ljn0099
+ *
+ * @license MIT License
+ * Copyright (c) 2025 ljn0099
+ *
+ * See LICENSE file for details.
+ */
+#ifndef PCF8523_CONFIG_H
+#define PCF8523_CONFIG_H
+
+#include "sensor/pcf8523.h"
+
+typedef struct {
+    pcf8523_PowerModes_t powerMode;
+    pcf8523_CapacitorValue_t capValue;
+    bool format24h;
+
+    // Masks of the pcf8523_InterruptSource_t values of each control register
+    uint8_t ctrl1Interrupts;
+    uint8_t ctrl2Interrupts;
+    uint8_t ctrl3Interrupts;
+
+    pcf8523_ClkOutFreq_t clkOutFreq;
+
+    pcf8523_TmrAMode_t tmrAMode;
+    pcf8523_TmrIntMode tmrAIntMode; // Shared with the second interrupt
+    pcf8523_ClkSourceFreq_t tmrASourceFreq;
+
+    bool tmrBEnabled;
+    pcf8523_TmrIntMode tmrBIntMode;
+    pcf8523_ClkSourceFreq_t tmrBSourceFreq;
+    pcf8523_TmrBIntWidth_t tmrBIntWidth;
+
+    pcf8523_OffsetMode_t offsetMode;
+    int8_t offset; // -64 to 63
+} pcf8523_Config_t;
+
+typedef struct {
+    uint8_t regs[PCF8523_REGISTER_COUNT];
+} pcf8523_State_t;
+
+/**
+ * @brief Reads the current configuration of the device with one burst read
+ */
+bool pcf8523_read_config(pcf8523_t *pcf8523, pcf8523_Config_t *config);
+
+/**
+ * @brief Brings the device to the given configuration writing only the registers that differ
+ *
+ * @param changed Optional, number of registers whose value was changed
+ */
+bool pcf8523_apply_config(pcf8523_t *pcf8523, const pcf8523_Config_t *config, uint8_t *changed);
+
+/**
+ * @brief Captures every register with one burst read
+ */
+bool pcf8523_save_state(pcf8523_t *pcf8523, pcf8523_State_t *state);
+
+/**
+ * @brief Writes a saved image back with one burst write
+ *
+ * Interrupt flags are written as 1 so none gets cleared, read only bits are ignored by the
+ * device. The timer value registers reload the countdowns with the values they had when saved.
+ *
+ * @param preserveTime Leaves the time registers (and the OS flag) alone, which splits the write
+ * in two bursts around them
+ */
+bool pcf8523_restore_state(pcf8523_t *pcf8523, const pcf8523_State_t *state, bool preserveTime);
+#endif
@@ -0,0 +1,62 @@
+/**
+ * @file pcf8523_datetime.h
+ * @brief Arithmetic on pcf8523_Datetime_t without epoch conversions
+ *
+ * The fields are carried the way the device counts: seconds into minutes, minutes into hours,
+ * hours into days and days into months and years. A small delta only touches the fields it
+ * overflows, and the day carry steps month by month (whole 4 year cycles are skipped first), so no
+ * calendar conversion or 64 bit division is involved.
+ *
+ * Like the PCF8523 every year divisible by 4 is a leap year, which is right for 2000 to 2099.
+ * Results outside years 00..99 are rejected and leave the datetime untouched. The week day is
+ * moved along with the date, keeping whatever numbering the datetime uses. 12h datetimes stay in
+ * 12h mode with AM/PM adjusted, 24h datetimes stay in 24h mode.
+ *
+ * Every function checks its datetimes, day against the length of the month included, and does so
+ * regardless of PCF8523_SKIP_VALIDATION.
+ *
+ * @author ljn0099
+ *
+ * @license MIT License
+ * Copyright (c) 2025 ljn0099
+ *
+ * See LICENSE file for details.
+ */
+#ifndef PCF8523_DATETIME_H
+#define PCF8523_DATETIME_H
+
+#include "sensor/pcf8523.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @brief Adds (or with a negative delta subtracts) seconds
+ *
+ * @return false if the datetime is invalid or the result leaves years 00..99
+ */
+bool pcf8523_datetime_add_seconds(pcf8523_Datetime_t *datetime, int32_t seconds);
+
+bool pcf8523_datetime_add_minutes(pcf8523_Datetime_t *datetime, int32_t minutes);
+
+bool pcf8523_datetime_add_days(pcf8523_Datetime_t *datetime, int32_t days);
+
+/**
+ * @brief Adds calendar months, the day is clamped to the length of the resulting month
+ *
+ * January 31 plus one month is February 28 (or 29), the time of day is kept.
+ */
+bool pcf8523_datetime_add_months(pcf8523_Datetime_t *datetime, int32_t months);
+
+/**
+ * @brief Orders two datetimes, 12h and 24h datetimes can be mixed
+ *
+ * @return Negative if a is before b, 0 if equal (or either is invalid), positive if a is after b
+ */
+int pcf8523_datetime_compare(const pcf8523_Datetime_t *a, const pcf8523_Datetime_t *b);
+
+/**
+ * @brief Seconds from b to a, negative if a is before b, 0 if either is invalid
+ */
+int64_t pcf8523_datetime_diff_seconds(const pcf8523_Datetime_t *a, const pcf8523_Datetime_t *b);
+#endif
@@ -0,0 +1,106 @@
+/**
+ * @file pcf8523_dual.h
+ * @brief Redundant clock built from two PCF8523, one on each I2C controller
+ *
+ * pcf8523_dual_read queues the same burst read (CTRL1..YEARS) in the TX FIFOs of both
+ * controllers before waiting for either of them, so the two transfers run at the same time and a
+ * redundant read takes as long as a single one. Each device is then rated:
+ *
+ * - unusable: the transfer failed, the OS flag is set, the clock is stopped or the registers do
+ *   not hold a valid datetime
+ * - degraded: battery low (BLF) or a switch over to the battery (BSF) was flagged
+ *
+ * A healthy device is preferred over a degraded one. When both are equally healthy but disagree by
+ * more than the tolerance, the one closer to the time predicted from the last selected reading and
+ * time_us_64 wins, and the last selected device is kept when there is no prediction yet.
+ *
+ * Both devices have to be attached with pcf8523_init_struct, to different controllers, and use the
+ * same hour format. The reads program the controllers directly instead of going through the
+ * transport, so pcf8523_dual_init refuses devices whose transport was replaced or wrapped
+ * (pcf8523_rtos, pcf8523_trace, pcf8523_bus_tuner): their locking, recording and error counting
+ * would be skipped, and the RTOS backend owns the controller interrupt. Nothing else may use the
+ * two controllers while pcf8523_dual_read runs.
+ *
+ * @author ljn0099
+ *
+ * @license MIT License
+ * Copyright (c) 2025 ljn0099
+ *
+ * See LICENSE file for details.
+ */
+#ifndef PCF8523_DUAL_H
+#define PCF8523_DUAL_H
+
+#include "sensor/pcf8523.h"
+
+#define PCF8523_DUAL_TIMEOUT_US 5000
+#define PCF8523_DUAL_TOLERANCE_S 1 // The two reads can straddle a second increment
+#define PCF8523_DUAL_NONE 0xFF
+
+typedef enum {
+    PCF8523_DUAL_HEALTH_BUS = (1 << 0),     // Transfer failed or timed out
+    PCF8523_DUAL_HEALTH_OS = (1 << 1),      // Oscillator stopped, time not guaranteed
+    PCF8523_DUAL_HEALTH_STOP = (1 << 2),    // Time frozen with the STOP bit
+    PCF8523_DUAL_HEALTH_INVALID = (1 << 3), // Time registers out of range
+    PCF8523_DUAL_HEALTH_BLF = (1 << 4),     // Battery low
+    PCF8523_DUAL_HEALTH_BSF = (1 << 5)      // Switched over to the battery
+} pcf8523_DualHealth_t;
+
+#define PCF8523_DUAL_HEALTH_UNUSABLE                                                               \
+    (PCF8523_DUAL_HEALTH_BUS | PCF8523_DUAL_HEALTH_OS | PCF8523_DUAL_HEALTH_STOP |                 \
+     PCF8523_DUAL_HEALTH_INVALID)
+
+typedef struct {
+    uint32_t reads;
+    uint32_t failedReads; // Neither device usable
+    uint32_t unusable[2];
+    uint32_t selected[2];
+    uint32_t switches; // Selected device changed
+
+    // Device 1 minus device 0 in seconds, over the reads where both were usable
+    uint32_t compared;
+    uint32_t disagreements; // Beyond the tolerance
+    int32_t lastDivergence;
+    int32_t minDivergence;
+    int32_t maxDivergence;
+    int64_t sumDivergence;
+
+    uint32_t lastReadUs;
+    uint32_t maxReadUs;
+} pcf8523_DualStats_t;
+
+typedef struct {
+    pcf8523_t *rtc[2];
+    uint16_t century;
+    uint32_t toleranceS;
+    uint32_t timeoutUs;
+
+    uint8_t health[2];
+    uint8_t selected;
+    bool predicted; // lastEpoch and lastUs hold a selected reading
+    uint64_t lastEpoch;
+    uint64_t lastUs;
+
+    pcf8523_DualStats_t stats;
+} pcf8523_Dual_t;
+
+bool pcf8523_dual_init(pcf8523_Dual_t *dual, pcf8523_t *rtc0, pcf8523_t *rtc1, uint16_t century);
+
+/**
+ * @brief Reads both devices at the same time and returns the time of the selected one
+ *
+ * @param source Index of the device used, can be NULL
+ *
+ * @return false if neither device is usable
+ */
+bool pcf8523_dual_read(pcf8523_Dual_t *dual, pcf8523_Datetime_t *datetime, uint8_t *source);
+
+/**
+ * @brief Health bits of the last read, pcf8523_DualHealth_t
+ */
+uint8_t pcf8523_dual_health(const pcf8523_Dual_t *dual, uint8_t index);
+
+bool pcf8523_dual_read_stats(const pcf8523_Dual_t *dual, pcf8523_DualStats_t *stats);
+
+void pcf8523_dual_reset_stats(pcf8523_Dual_t *dual);
+#endif
@@ -0,0 +1,57 @@
+/**
+ * @file pcf8523_edge.h
+ * @brief Wait for the next RTC second boundary
+ *
+ * With INT1 wired to a GPIO the second interrupt (SIE, pulsed mode) is used and the edge is found
+ * by sampling the pin, so no bus traffic happens per edge. Without it the seconds register is
+ * polled: the first edge is found with a coarse poll, later ones by sleeping until shortly before
+ * the predicted edge and polling only from there, so a few reads are spent per edge.
+ *
+ * Every edge is returned as a time_us_64() timestamp together with an uncertainty bound.
+ *
+ * @author ljn0099
+ *
+ * @license MIT License
+ * Copyright (c) 2025 ljn0099
+ *
+ * See LICENSE file for details.
+ */
+#ifndef PCF8523_EDGE_H
+#define PCF8523_EDGE_H
+
+#include "sensor/pcf8523.h"
+
+#define PCF8523_EDGE_NO_PIN (-1)
+#define PCF8523_EDGE_COARSE_POLL_US 10000 // Poll interval until the first edge is known
+#define PCF8523_EDGE_GUARD_US 1000        // Minimum wake up time before a predicted edge
+#define PCF8523_EDGE_DRIFT_PPM 200        // Crystal against time_us_64() worst case
+
+typedef struct {
+    pcf8523_t *pcf8523;
+    int intPin;
+
+    bool locked; // lastEdgeUs is a known RTC second edge
+    uint64_t lastEdgeUs;
+    uint32_t lastUncertaintyUs;
+    uint32_t reads; // Bus reads spent while waiting
+} pcf8523_SecondEdge_t;
+
+/**
+ * @brief Prepares the edge detector
+ *
+ * @param intPin GPIO connected to INT1 or PCF8523_EDGE_NO_PIN to poll the seconds register. When
+ * a pin is given the second interrupt is enabled in pulsed mode.
+ */
+bool pcf8523_second_edge_init(pcf8523_SecondEdge_t *edge, pcf8523_t *pcf8523, int intPin);
+
+/**
+ * @brief Waits for the next RTC second boundary
+ *
+ * @param edgeUs time_us_64() timestamp of the edge
+ * @param uncertaintyUs Optional, maximum distance between edgeUs and the real edge
+ *
+ * @return false on bus errors or when no edge is seen within timeoutUs
+ */
+bool pcf8523_wait_second_edge(pcf8523_SecondEdge_t *edge, uint64_t timeoutUs, uint64_t *edgeUs,
+                              uint32_t *uncertaintyUs);
+#endif
@@ -0,0 +1,118 @@
+/**
+ * @file pcf8523_id.h
+ * @brief Time ordered 128 and 64 bit IDs anchored on the RTC
+ *
+ * The RTC is read at init and at every resync, in between the time comes from a free running
+ * microsecond clock (time_us_64 on the Pico), so generating an ID never touches the bus.
+ *
+ * The 128 bit IDs are UUIDv7 (RFC 9562): 48 bit Unix time in ms, version, 12 bits of
+ * sub-millisecond time, variant, a 30 bit counter and a 32 bit node. Their big endian bytes also
+ * sort as ULIDs and can be printed in either form. The 64 bit IDs are 41 bits of ms since
+ * 2000-01-01, a 10 bit node and a 13 bit counter.
+ *
+ * The RTC only has 1 s resolution, so a resync keeps the current sub-second phase and only moves
+ * the anchor when the prediction left the second read from the device, which narrows the phase
+ * over successive resyncs. IDs never go backwards: when the time steps back (a resync or the RTC
+ * being set) or the counter runs out, the last timestamp is carried forward until the clock
+ * catches up.
+ *
+ * The generator is not reentrant, guard it when it is shared between cores or tasks.
+ *
+ * @author ljn0099
+ *
+ * @license MIT License
+ * Copyright (c) 2025 ljn0099
+ *
+ * See LICENSE file for details.
+ */
+#ifndef PCF8523_ID_H
+#define PCF8523_ID_H
+
+#include "sensor/pcf8523.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define PCF8523_ID_UUID_LEN 37 // 8-4-4-4-12 hex digits and the terminator
+#define PCF8523_ID_ULID_LEN 27 // 26 Crockford base32 digits and the terminator
+
+#define PCF8523_ID64_EPOCH_MS 946684800000ULL // 2000-01-01T00:00:00Z
+#define PCF8523_ID64_NODE_BITS 10
+#define PCF8523_ID64_COUNTER_BITS 13
+#define PCF8523_ID128_COUNTER_BITS 30
+
+typedef uint64_t (*pcf8523_IdClock_t)(void);
+
+typedef struct {
+    uint8_t bytes[16]; // Big endian, as written in the UUID string
+} pcf8523_Id128_t;
+
+typedef struct {
+    uint64_t last; // Timestamp of the last ID, in the unit of the layout
+    uint32_t counter;
+} pcf8523_IdSequence_t;
+
+typedef struct {
+    pcf8523_t *pcf8523;
+    uint16_t century;
+    pcf8523_IdClock_t clock;
+    uint32_t node;
+
+    // Unix time in us at clock() == anchorClockUs
+    uint64_t anchorEpochUs;
+    uint64_t anchorClockUs;
+
+    pcf8523_IdSequence_t seq128; // In us
+    pcf8523_IdSequence_t seq64;  // In ms
+
+    // Unix ms containing the last timestamp and the us it started at
+    uint64_t ms;
+    uint64_t msStartUs;
+
+    uint32_t resyncs;
+    uint32_t adjustments; // Resyncs that moved the anchor
+    uint32_t carried;     // IDs whose timestamp was carried forward
+} pcf8523_IdGen_t;
+
+/**
+ * @brief Reads the RTC and anchors the generator on it
+ *
+ * @param clock Free running microsecond clock (time_us_64 on the Pico)
+ * @param node Device identifier, the 64 bit IDs keep its low 10 bits
+ */
+bool pcf8523_id_init(pcf8523_IdGen_t *gen, pcf8523_t *pcf8523, uint16_t century,
+                     pcf8523_IdClock_t clock, uint32_t node);
+
+/**
+ * @brief Reads the RTC again and corrects the anchor if the prediction left the RTC second
+ */
+bool pcf8523_id_resync(pcf8523_IdGen_t *gen);
+
+/**
+ * @brief Anchors on an exactly known instant, for example an RTC second edge
+ *
+ * @param clockUs clock() value at which the Unix time was epoch.000000
+ */
+void pcf8523_id_anchor(pcf8523_IdGen_t *gen, uint64_t epoch, uint64_t clockUs);
+
+void pcf8523_id_next128(pcf8523_IdGen_t *gen, pcf8523_Id128_t *id);
+
+uint64_t pcf8523_id_next64(pcf8523_IdGen_t *gen);
+
+/**
+ * @brief Fills ids with consecutive IDs, reading the clock once
+ */
+void pcf8523_id_next128_batch(pcf8523_IdGen_t *gen, pcf8523_Id128_t *ids, size_t count);
+
+void pcf8523_id_format_uuid(const pcf8523_Id128_t *id, char *buffer);
+
+void pcf8523_id_format_ulid(const pcf8523_Id128_t *id, char *buffer);
+
+/**
+ * @brief Unix time in ms stored in an ID
+ */
+uint64_t pcf8523_id128_unix_ms(const pcf8523_Id128_t *id);
+
+uint64_t pcf8523_id64_unix_ms(uint64_t id);
+#endif
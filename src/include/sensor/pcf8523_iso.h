@@ -0,0 +1,73 @@
+/**
+ * @file pcf8523_iso.h
+ * @brief ISO 8601 / RFC 3339 formatting and parsing without printf or scanf
+ *
+ * The extended format is written as YYYY-MM-DDTHH:MM:SS, optionally followed by a fraction of
+ * 1 to 9 digits and a zone designator ("Z" or +HH:MM). Digits are emitted two at a time from a
+ * table, so formatting a timestamp is a few dozen stores and no division by 10 per digit.
+ *
+ * The parsers accept the same format with 'T', 't' or a space as separator, any number of
+ * fraction digits (only the first 9 are kept), and "Z", "z", +HH:MM or +HHMM as zone. They return
+ * the number of characters consumed, so a timestamp at the start of a log line can be parsed in
+ * place.
+ *
+ * Datetimes are always produced in 24h mode, 12h datetimes are converted when formatted.
+ *
+ * @author ljn0099
+ *
+ * @license MIT License
+ * Copyright (c) 2025 ljn0099
+ *
+ * See LICENSE file for details.
+ */
+#ifndef PCF8523_ISO_H
+#define PCF8523_ISO_H
+
+#include "sensor/pcf8523.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define PCF8523_ISO_MAX_LEN 36 // 2024-01-01T00:00:00.123456789+01:00 and the terminator
+
+#define PCF8523_ISO_NO_ZONE INT16_MIN // No zone designator, local time
+#define PCF8523_ISO_UTC 0             // Written as "Z"
+
+typedef struct {
+    uint32_t fraction;      // Value of the fraction digits, 123 with 3 digits is .123
+    uint8_t fractionDigits; // 0 omits the fraction
+    int16_t offsetMin;      // Zone offset in minutes, PCF8523_ISO_UTC or PCF8523_ISO_NO_ZONE
+} pcf8523_IsoOptions_t;
+
+/**
+ * @brief Formats a datetime, options can be NULL for second resolution without zone
+ *
+ * @return Length written without the terminator, 0 if the buffer is too small or the datetime is
+ * invalid
+ */
+size_t pcf8523_iso_format(const pcf8523_Datetime_t *datetime, uint16_t century,
+                          const pcf8523_IsoOptions_t *options, char *buffer, size_t size);
+
+/**
+ * @brief Formats a UTC epoch, shifted to the zone given in the options
+ */
+size_t pcf8523_iso_format_epoch(uint64_t epoch, const pcf8523_IsoOptions_t *options, char *buffer,
+                                size_t size);
+
+/**
+ * @brief Parses the local date and time as written, the week day is computed
+ *
+ * @param nanos Fraction in ns, can be NULL
+ * @param offsetMin Zone offset, PCF8523_ISO_NO_ZONE when absent, can be NULL
+ *
+ * @return Characters consumed, 0 on error
+ */
+size_t pcf8523_iso_parse(const char *str, pcf8523_Datetime_t *datetime, uint16_t *century,
+                         uint32_t *nanos, int16_t *offsetMin);
+
+/**
+ * @brief Parses a timestamp into a UTC epoch, a timestamp without zone is taken as UTC
+ */
+size_t pcf8523_iso_parse_epoch(const char *str, uint64_t *epoch, uint32_t *nanos);
+#endif
@@ -0,0 +1,32 @@
+/**
+ * @file pcf8523_linux.h
+ * @brief Linux i2c-dev transport for the PCF8523 driver
+ *
+ * Every register access is issued as a single I2C_RDWR ioctl. Reads combine the register address
+ * write and the data read with a repeated start, so they cost one syscall instead of a write()
+ * followed by a read().
+ *
+ * @author ljn0099
+ *
+ * @license MIT License
+ * Copyright (c) 2025 ljn0099
+ *
+ * See LICENSE file for details.
+ */
+#ifndef PCF8523_LINUX_H
+#define PCF8523_LINUX_H
+
+#include "sensor/pcf8523.h"
+
+typedef struct {
+    int fd;
+    uint32_t transfers; // ioctl calls issued
+    uint32_t errors;
+} pcf8523_LinuxI2c_t;
+
+extern const pcf8523_Transport_t pcf8523_linux_transport;
+
+bool pcf8523_linux_i2c_open(pcf8523_LinuxI2c_t *bus, const char *device);
+
+void pcf8523_linux_i2c_close(pcf8523_LinuxI2c_t *bus);
+#endif
@@ -0,0 +1,88 @@
+/**
+ * @file pcf8523_log.h
+ * @brief Time-indexed event log stored in a flash ring, stamped with the PCF8523 epoch
+ *
+ * Records have a fixed size and are appended to a ring of erase blocks. Each block starts with a
+ * header holding a sequence number and the epoch of its first record, so a mount only has to read
+ * the block headers (plus a binary search inside the newest block) to find the write head again
+ * after a power loss. The first epoch of every block is kept in a caller-provided array which is
+ * used for O(log n) time-range lookups.
+ *
+ * The log only talks to the flash through pcf8523_LogFlash_t, so any storage with NOR semantics
+ * (erase to 0xFF, program clears bits) can be used.
+ *
+ * @author ljn0099
+ *
+ * @license MIT License
+ * Copyright (c) 2025 ljn0099
+ *
+ * See LICENSE file for details.
+ */
+#ifndef PCF8523_LOG_H
+#define PCF8523_LOG_H
+
+#include "sensor/pcf8523.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define PCF8523_LOG_HEADER_SIZE 16
+#define PCF8523_LOG_MAX_RECORD_SIZE 64
+
+typedef struct {
+    // All offsets are relative to the start of the log region
+    bool (*read)(void *ctx, uint32_t offset, uint8_t *data, size_t len);
+    bool (*program)(void *ctx, uint32_t offset, const uint8_t *data, size_t len);
+    bool (*erase)(void *ctx, uint32_t offset, size_t len);
+    void *ctx;
+    uint32_t blockSize;
+} pcf8523_LogFlash_t;
+
+typedef struct {
+    const pcf8523_LogFlash_t *flash;
+    uint32_t *index; // First epoch of every block, blockCount entries
+    uint16_t blockCount;
+    uint16_t recordSize;
+    uint16_t slotSize;
+    uint16_t slotsPerBlock;
+
+    uint16_t tailBlock;
+    uint16_t usedBlocks;
+    uint16_t headSlot;
+    uint32_t sequence;
+    uint32_t lastEpoch;
+} pcf8523_Log_t;
+
+typedef struct {
+    uint16_t block; // Logical block, 0 is the oldest one
+    uint16_t slot;
+} pcf8523_LogCursor_t;
+
+bool pcf8523_log_init(pcf8523_Log_t *log, const pcf8523_LogFlash_t *flash, uint16_t blockCount,
+                      uint16_t recordSize, uint32_t *index);
+
+bool pcf8523_log_format(pcf8523_Log_t *log);
+
+bool pcf8523_log_append(pcf8523_Log_t *log, uint32_t epoch, const void *record);
+
+bool pcf8523_log_append_now(pcf8523_Log_t *log, pcf8523_t *pcf8523, uint16_t century,
+                            const void *record);
+
+uint32_t pcf8523_log_count(const pcf8523_Log_t *log);
+
+bool pcf8523_log_find(pcf8523_Log_t *log, uint32_t fromEpoch, pcf8523_LogCursor_t *cursor);
+
+bool pcf8523_log_next(pcf8523_Log_t *log, pcf8523_LogCursor_t *cursor, uint32_t toEpoch,
+                      uint32_t *epoch, void *record);
+
+#ifndef PCF8523_HOST_BUILD
+/**
+ * @brief Log region in the on-board flash, flashOffset must be sector aligned
+ *
+ * Program and erase run through flash_safe_execute. When the other core is running it has to
+ * call flash_safe_execute_core_init() first, otherwise the operation times out and fails.
+ */
+bool pcf8523_log_pico_flash_init(pcf8523_LogFlash_t *flash, uint32_t flashOffset);
+#endif
+#endif
@@ -0,0 +1,99 @@
+/**
+ * @file pcf8523_mirror.h
+ * @brief Mirror of the PCF8523 time in the on-chip always-on timer
+ *
+ * The time is copied into the RP2040 RTC or the RP2350 always-on timer (through pico_aon_timer)
+ * right after an RTC second edge, so afterwards the local reads are served from the chip with a
+ * few register loads instead of an I2C transaction. pcf8523_mirror_poll re-aligns the copy on a
+ * schedule, every interval seconds (1 re-aligns on every second edge).
+ *
+ * Every synchronization measures the divergence of the on-chip clock first: its own second edge is
+ * searched inside a window around the predicted RTC edge, which gives the offset with microsecond
+ * resolution even on the RP2040 where the RTC only counts whole seconds. Offsets outside the
+ * window are only known to the second. The copy is re-aligned when the offset exceeds the
+ * threshold.
+ *
+ * A synchronization blocks until the RTC second edge (at most about one second, see
+ * pcf8523_edge.h). The RP2040 RTC can only be set to whole seconds, so there a re-alignment waits
+ * for one more edge and sets the clock right at it.
+ *
+ * @author ljn0099
+ *
+ * @license MIT License
+ * Copyright (c) 2025 ljn0099
+ *
+ * See LICENSE file for details.
+ */
+#ifndef PCF8523_MIRROR_H
+#define PCF8523_MIRROR_H
+
+#include "sensor/pcf8523.h"
+#include "sensor/pcf8523_edge.h"
+
+#define PCF8523_MIRROR_WINDOW_US 20000    // Local edge search around the RTC edge
+#define PCF8523_MIRROR_REALIGN_US 2000    // Default re-alignment threshold
+#define PCF8523_MIRROR_EDGE_TIMEOUT_US 2500000
+
+typedef struct {
+    uint32_t syncs;
+    uint32_t realigns;
+    uint32_t coarseSyncs;     // Local edge outside the window, offset known to the second
+    int64_t lastDivergenceUs; // On-chip clock minus the RTC, positive when the copy runs ahead
+    int64_t maxDivergenceUs;  // Largest magnitude seen
+    uint64_t accumulatedUs;   // Sum of the corrected offsets
+} pcf8523_MirrorStats_t;
+
+typedef struct {
+    pcf8523_t *pcf8523;
+    uint16_t century;
+    pcf8523_SecondEdge_t edge;
+
+    uint32_t intervalS;    // Re-alignment schedule, 0 only syncs on request
+    uint32_t thresholdUs;  // Offsets below it are only reported
+    uint64_t lastSyncUs;
+
+    // Last datetime handed out, later reads carry from it
+    bool cached;
+    uint64_t cachedEpoch;
+    pcf8523_Datetime_t cachedDatetime;
+
+    pcf8523_MirrorStats_t stats;
+} pcf8523_Mirror_t;
+
+/**
+ * @brief Starts the on-chip clock from the RTC
+ *
+ * @param intPin INT1 GPIO for the edge detection or PCF8523_EDGE_NO_PIN, see pcf8523_edge.h
+ * @param intervalS Seconds between re-alignments done by pcf8523_mirror_poll, 0 disables them
+ */
+bool pcf8523_mirror_init(pcf8523_Mirror_t *mirror, pcf8523_t *pcf8523, uint16_t century,
+                         int intPin, uint32_t intervalS);
+
+/**
+ * @brief Measures the divergence at the next RTC second edge and re-aligns if needed
+ *
+ * @param divergenceUs Optional, the measured offset
+ */
+bool pcf8523_mirror_sync(pcf8523_Mirror_t *mirror, int64_t *divergenceUs);
+
+/**
+ * @brief Runs pcf8523_mirror_sync when the schedule is due
+ *
+ * @return false only when a due sync failed
+ */
+bool pcf8523_mirror_poll(pcf8523_Mirror_t *mirror);
+
+/**
+ * @brief Reads the mirrored time without bus traffic
+ *
+ * @param nanos Optional, sub-second part (always 0 on the RP2040)
+ */
+bool pcf8523_mirror_read_epoch(pcf8523_Mirror_t *mirror, uint64_t *epoch, uint32_t *nanos);
+
+/**
+ * @brief Reads the mirrored time in the hour format of the device without bus traffic
+ */
+bool pcf8523_mirror_read_datetime(pcf8523_Mirror_t *mirror, pcf8523_Datetime_t *datetime);
+
+bool pcf8523_mirror_read_stats(const pcf8523_Mirror_t *mirror, pcf8523_MirrorStats_t *stats);
+#endif
@@ -0,0 +1,57 @@
+/**
+ * @file pcf8523_precise.h
+ * @brief Sub-millisecond time setting aligned with the STOP bit
+ *
+ * Setting STOP holds the prescaler in reset, and the first second increment after STOP is
+ * released happens 0.507813 s to 0.507935 s later. pcf8523_set_datetime_precise freezes the
+ * clock, pre-loads the target second and releases STOP that long before the following second
+ * boundary of the reference clock, busy waiting on time_us_64() (with interrupts disabled) for
+ * the last part. The release write is started early by its own measured bus time.
+ *
+ * Afterwards the seconds register is polled around the expected increment, so the residual error
+ * of the RTC second edge against the reference boundary is measured rather than assumed.
+ *
+ * The release write runs with interrupts disabled, so the transport has to complete without them.
+ * With pcf8523_rtos the call goes inside pcf8523_rtos_exclusive_begin / _end, which hold the
+ * device mutex and switch its owner to polled transfers meanwhile.
+ *
+ * @author ljn0099
+ *
+ * @license MIT License
+ * Copyright (c) 2025 ljn0099
+ *
+ * See LICENSE file for details.
+ */
+#ifndef PCF8523_PRECISE_H
+#define PCF8523_PRECISE_H
+
+#include "sensor/pcf8523.h"
+
+#define PCF8523_STOP_RELEASE_DELAY_US 507874  // Middle of the documented first increment window
+#define PCF8523_PRECISE_SPIN_US 500           // Busy wait before the release
+#define PCF8523_PRECISE_EDGE_GUARD_US 2000    // Polling starts this long before the expected edge
+#define PCF8523_PRECISE_UNKNOWN_US UINT32_MAX // uncertaintyUs when the edge could not be measured
+
+typedef struct {
+    uint64_t releaseUs;    // time_us_64() at the end of the STOP release write
+    int32_t releaseErrorUs; // Release instant against the scheduled one
+    int32_t errorUs;        // Measured RTC second edge minus the reference boundary
+    uint32_t uncertaintyUs; // Half the polling interval that bracketed the edge
+} pcf8523_PreciseSet_t;
+
+/**
+ * @brief Sets the datetime so that it becomes the RTC time at the reference instant boundaryUs
+ *
+ * @param datetime Time that the RTC shows from boundaryUs (time_us_64() timebase) on
+ * @param boundaryUs Reference second boundary, at least about half a second in the future
+ * @param result Optional, filled with the measured residual error. When the RTC was set but the
+ * edge measurement afterwards failed, errorUs is 0 and uncertaintyUs PCF8523_PRECISE_UNKNOWN_US
+ *
+ * @return true once the RTC has been set and released on time, whether the edge could be measured
+ * or not. false on a bus error before that or when boundaryUs is too close. STOP is released again
+ * on the way out if the clock had been frozen, so the RTC keeps running but its time and phase are
+ * arbitrary
+ */
+bool pcf8523_set_datetime_precise(pcf8523_t *pcf8523, pcf8523_Datetime_t *datetime,
+                                  uint64_t boundaryUs, pcf8523_PreciseSet_t *result);
+#endif
@@ -0,0 +1,146 @@
+/**
+ * @file pcf8523_rtos.h
+ * @brief FreeRTOS integration: per device mutex, I2C completion by task notification and INT1
+ * events through a queue
+ *
+ * pcf8523_rtos_init wraps the transport of a pcf8523_t, so every transfer made afterwards runs
+ * under the device mutex and is started on an asynchronous bus backend. The calling task sleeps on
+ * a task notification (index PCF8523_RTOS_NOTIFY_INDEX) until the backend reports the completion
+ * with pcf8523_rtos_transfer_done_from_isr.
+ *
+ * The mutex is taken per transfer, not per pcf8523_* call: calls made of several transfers, such
+ * as the read-modify-write of pcf8523_enable_interrupt_source, can interleave with other tasks.
+ * The mutex is recursive, so wrapping such calls (or any sequence of them) in pcf8523_rtos_lock /
+ * pcf8523_rtos_unlock makes them atomic.
+ *
+ * Transfers made with interrupts disabled (pcf8523_set_datetime_precise, pcf8523_sync_run) never
+ * see their completion here. They have to run inside pcf8523_rtos_exclusive_begin / _end.
+ *
+ * The INT1 GPIO interrupt only has to call pcf8523_rtos_signal_int_from_isr. The service task
+ * then reads CTRL1..CTRL3 in one burst, clears the pending flags and posts them as a
+ * pcf8523_RtosEvent_t, which pcf8523_rtos_wait_event delivers to the waiting task.
+ *
+ * @author ljn0099
+ *
+ * @license MIT License
+ * Copyright (c) 2025 ljn0099
+ *
+ * See LICENSE file for details.
+ */
+#ifndef PCF8523_RTOS_H
+#define PCF8523_RTOS_H
+
+#include "FreeRTOS.h"
+#include "queue.h"
+#include "semphr.h"
+#include "task.h"
+
+#include "sensor/pcf8523.h"
+
+#ifndef PCF8523_RTOS_NOTIFY_INDEX
+#define PCF8523_RTOS_NOTIFY_INDEX 1 // Index 0 is left to the application
+#endif
+
+#define PCF8523_RTOS_INT_NOTIFY_INDEX 0 // Only used by the service task
+
+#if PCF8523_RTOS_NOTIFY_INDEX == PCF8523_RTOS_INT_NOTIFY_INDEX
+#error "PCF8523_RTOS_NOTIFY_INDEX must not be 0"
+#endif
+
+#if PCF8523_RTOS_NOTIFY_INDEX >= configTASK_NOTIFICATION_ARRAY_ENTRIES
+#error "configTASK_NOTIFICATION_ARRAY_ENTRIES must be greater than PCF8523_RTOS_NOTIFY_INDEX"
+#endif
+
+#define PCF8523_RTOS_EVENT_QUEUE_LEN 8
+
+// Asynchronous bus backend, the start functions return as soon as the transfer is queued
+typedef struct {
+    bool (*start_read)(void *ctx, uint8_t i2cAddress, uint8_t startReg, uint8_t *data,
+                       size_t len);
+    bool (*start_write)(void *ctx, uint8_t i2cAddress, const uint8_t *frame, size_t frameLen);
+    void (*abort)(void *ctx); // Optional, called when the completion times out
+
+    // Optional blocking transfers for exclusive sections, they must complete with interrupts
+    // disabled and are only called while no asynchronous transfer is running
+    bool (*read_polled)(void *ctx, uint8_t i2cAddress, uint8_t startReg, uint8_t *data,
+                        size_t len);
+    bool (*write_polled)(void *ctx, uint8_t i2cAddress, const uint8_t *frame, size_t frameLen);
+} pcf8523_RtosBus_t;
+
+typedef struct {
+    uint8_t ctrl2Flags; // pcf8523_InterruptFlag_t bits of CTRL2
+    uint8_t ctrl3Flags; // pcf8523_InterruptFlag_t bits of CTRL3
+    TickType_t tick;
+} pcf8523_RtosEvent_t;
+
+typedef struct {
+    pcf8523_t *pcf8523;
+    const pcf8523_RtosBus_t *bus;
+    void *busCtx;
+    TickType_t timeout;
+
+    SemaphoreHandle_t mutex;
+    StaticSemaphore_t mutexBuffer;
+
+    TaskHandle_t volatile waiter;
+    volatile bool ok;
+    uint8_t exclusiveDepth; // Only changed by the task holding the mutex
+
+    TaskHandle_t intTask;
+    QueueHandle_t events;
+    StaticQueue_t eventsBuffer;
+    uint8_t eventsStorage[PCF8523_RTOS_EVENT_QUEUE_LEN * sizeof(pcf8523_RtosEvent_t)];
+
+    uint32_t timeouts;
+    uint32_t droppedEvents;
+} pcf8523_Rtos_t;
+
+bool pcf8523_rtos_init(pcf8523_Rtos_t *rtos, pcf8523_t *pcf8523, const pcf8523_RtosBus_t *bus,
+                       void *busCtx, TickType_t timeout);
+
+bool pcf8523_rtos_lock(pcf8523_Rtos_t *rtos, TickType_t timeout);
+
+void pcf8523_rtos_unlock(pcf8523_Rtos_t *rtos);
+
+/**
+ * @brief Takes the device mutex and switches its owner to the polled transfers of the backend
+ *
+ * For code that talks to the RTC with interrupts disabled, such as pcf8523_set_datetime_precise
+ * and pcf8523_sync_run: a transfer on the notification driven path would wait for a completion
+ * interrupt that cannot arrive. Until pcf8523_rtos_exclusive_end the calling task re-enters the
+ * mutex it already holds (which neither blocks nor touches the interrupts) and runs its transfers
+ * on read_polled / write_polled. The transport of the pcf8523_t is left as it is, so every other
+ * task, the INT service task included, keeps waiting on the mutex, which can be seconds for a
+ * precise set. Sections nest, false if the backend has no polled transfers.
+ */
+bool pcf8523_rtos_exclusive_begin(pcf8523_Rtos_t *rtos, TickType_t timeout);
+
+/**
+ * @brief Ends the section, from the task that began it
+ */
+void pcf8523_rtos_exclusive_end(pcf8523_Rtos_t *rtos);
+
+/**
+ * @brief Completion of the transfer started by the backend, from its interrupt handler
+ */
+void pcf8523_rtos_transfer_done_from_isr(pcf8523_Rtos_t *rtos, bool ok,
+                                         BaseType_t *higherPriorityTaskWoken);
+
+/**
+ * @brief Same as pcf8523_rtos_transfer_done_from_isr for backends completing in task context
+ */
+void pcf8523_rtos_transfer_done(pcf8523_Rtos_t *rtos, bool ok);
+
+/**
+ * @brief Creates the task that turns INT1 edges into events
+ */
+bool pcf8523_rtos_start_int_task(pcf8523_Rtos_t *rtos, UBaseType_t priority,
+                                 configSTACK_DEPTH_TYPE stackDepth);
+
+void pcf8523_rtos_signal_int_from_isr(pcf8523_Rtos_t *rtos, BaseType_t *higherPriorityTaskWoken);
+
+void pcf8523_rtos_signal_int(pcf8523_Rtos_t *rtos);
+
+bool pcf8523_rtos_wait_event(pcf8523_Rtos_t *rtos, pcf8523_RtosEvent_t *event,
+                             TickType_t timeout);
+#endif
@@ -0,0 +1,47 @@
+/**
+ * @file pcf8523_rtos_pico.h
+ * @brief Interrupt driven RP2040 / RP2350 I2C backend for pcf8523_rtos
+ *
+ * The command words are streamed to IC_DATA_CMD and the read bytes out of it by DMA. The I2C STOP
+ * detection (or transmit abort) interrupt reports the completion, so no core is held while the
+ * transfer runs. i2c_init has to be called on the instance first. One backend owns the whole I2C
+ * instance: devices on the same bus have to share it (and the pcf8523_Rtos_t).
+ *
+ * The polled transfers of pcf8523_rtos_exclusive_begin use the SDK blocking calls. The controller
+ * is idle between asynchronous transfers (DMA requests and interrupts masked), so they can use it.
+ *
+ * @author ljn0099
+ *
+ * @license MIT License
+ * Copyright (c) 2025 ljn0099
+ *
+ * See LICENSE file for details.
+ */
+#ifndef PCF8523_RTOS_PICO_H
+#define PCF8523_RTOS_PICO_H
+
+#include "hardware/i2c.h"
+#include "sensor/pcf8523_rtos.h"
+
+typedef struct {
+    i2c_inst_t *i2c;
+    pcf8523_Rtos_t *rtos;
+    uint txChannel;
+    uint rxChannel;
+
+    volatile bool active;
+    volatile bool reading;
+    volatile bool failed;
+    uint32_t cmd[PCF8523_FRAME_SIZE(PCF8523_REGISTER_COUNT)];
+} pcf8523_RtosPicoBus_t;
+
+extern const pcf8523_RtosBus_t pcf8523_rtos_pico_bus;
+
+/**
+ * @brief Claims two DMA channels and the I2C interrupt of the instance
+ *
+ * @param rtos Receives the completions, it may be initialized afterwards
+ */
+bool pcf8523_rtos_pico_bus_init(pcf8523_RtosPicoBus_t *bus, i2c_inst_t *i2c,
+                                pcf8523_Rtos_t *rtos);
+#endif
@@ -0,0 +1,58 @@
+/**
+ * @file pcf8523_sleep.h
+ * @brief Sleep until a wall clock deadline with computed waits instead of polling
+ *
+ * The RTC is read once and the interval to the deadline is slept on the Pico timer. As the
+ * registers only have a 1 s resolution, the phase of the RTC second is bisected with one byte reads
+ * of the seconds register, one per second edge while the wait runs (about 9 edges to get from 1 s
+ * to the final bracket). The deadline edge is then predicted on time_us_64() and the core sleeps
+ * until a guard band before it, sized for the remaining phase uncertainty and the drift between
+ * the crystal and the Pico timer. Only inside that band the seconds register is polled back to
+ * back.
+ *
+ * Long waits (where the drift alone would make the band wide) refine the phase once more a few
+ * seconds before the deadline. Deadlines too close for the bisection end with a coarse poll.
+ *
+ * @author ljn0099
+ *
+ * @license MIT License
+ * Copyright (c) 2025 ljn0099
+ *
+ * See LICENSE file for details.
+ */
+#ifndef PCF8523_SLEEP_H
+#define PCF8523_SLEEP_H
+
+#include "sensor/pcf8523.h"
+
+#define PCF8523_SLEEP_PHASE_US 2000          // Phase uncertainty left by the bisection
+#define PCF8523_SLEEP_GUARD_US 1000          // Added to every guard band
+#define PCF8523_SLEEP_DRIFT_PPM 200          // Crystal against time_us_64() worst case
+#define PCF8523_SLEEP_MAX_GUARD_US 20000     // Wider bands are narrowed by a re-synchronization
+#define PCF8523_SLEEP_RESYNC_LEAD_US 8000000 // Refinement before the deadline of long waits
+#define PCF8523_SLEEP_COARSE_POLL_US 10000   // Outside the predicted band
+
+typedef struct {
+    int64_t latenessUs;     // From the deadline edge to the return, negative never happens
+    uint32_t uncertaintyUs; // Of the edge estimate, 1 s if the deadline had already passed
+    uint32_t reads;         // Bus reads spent
+    uint32_t wakeups;       // Timer sleeps
+} pcf8523_SleepResult_t;
+
+/**
+ * @brief Sleeps until the RTC reaches deadline
+ *
+ * @param result Optional lateness and cost of the wait
+ *
+ * If the RTC is set while waiting, a jump past the deadline ends the wait with a one second
+ * uncertainty and a jump back makes it fail. A clock that stops counting fails one second after
+ * the predicted edge.
+ *
+ * @return false on bus errors, if the oscillator stop flag is set or the clock is frozen (STOP)
+ */
+bool pcf8523_sleep_until(pcf8523_t *pcf8523, const pcf8523_Datetime_t *deadline, uint16_t century,
+                         pcf8523_SleepResult_t *result);
+
+bool pcf8523_sleep_until_epoch(pcf8523_t *pcf8523, uint64_t deadline, uint16_t century,
+                               pcf8523_SleepResult_t *result);
+#endif
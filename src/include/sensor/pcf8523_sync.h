@@ -0,0 +1,134 @@
+/**
+ * @file pcf8523_sync.h
+ * @brief Host to device time synchronisation with round trip compensation (NTP style)
+ *
+ * The device sends a number of requests stamped with time_us_64() (t1), the host answers each
+ * one with its receive (t2) and transmit (t3) times in microseconds of Unix time, and the device
+ * stamps the answer when it arrives (t4). Every round gives
+ *
+ *     offset = ((t2 - t1) + (t3 - t4)) / 2    (host clock minus device clock)
+ *     delay  = (t4 - t1) - (t3 - t2)          (time spent on the link)
+ *
+ * and the offset error is at most delay / 2, so only the round with the smallest delay is kept:
+ * scheduling and USB polling only ever add delay, and the least delayed round is the one they
+ * disturbed least. Requests are padded to the length of the responses, so the serialisation time
+ * of the frames is the same in both directions and cancels out.
+ *
+ * pcf8523_sync_run then picks the next whole host second, converts it to the device timebase and
+ * sets the RTC on that boundary with pcf8523_set_datetime_precise (STOP bit prescaler reset), and
+ * sends back a report with the offset, the delay and the measured edge error. The messages travel
+ * as pcf8523_telemetry records, so the frames are COBS + CRC protected and can share the link
+ * with the telemetry stream.
+ *
+ * The protocol functions are shared with the host build, where the host side and a simulated
+ * device use them (examples/time_sync.c).
+ *
+ * @author ljn0099
+ *
+ * @license MIT License
+ * Copyright (c) 2025 ljn0099
+ *
+ * See LICENSE file for details.
+ */
+#ifndef PCF8523_SYNC_H
+#define PCF8523_SYNC_H
+
+#include "sensor/pcf8523.h"
+#include "sensor/pcf8523_telemetry.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define PCF8523_SYNC_DEFAULT_ROUNDS 16
+#define PCF8523_SYNC_ROUND_TIMEOUT_US 100000 // A request without answer by then is dropped
+#define PCF8523_SYNC_SET_LEAD_US 500000      // Least time from the last round to the boundary
+
+typedef struct {
+    uint32_t epoch;         // Unix time the RTC shows from the boundary on
+    int64_t offsetUs;       // Host clock minus device clock, from the least delayed round
+    uint32_t delayUs;       // Link delay of that round, the offset is within +-delayUs / 2
+    uint32_t maxDelayUs;    // Largest delay among the answered rounds
+    uint8_t rounds;         // Answered rounds
+    int32_t errorUs;        // Measured RTC second edge minus the boundary (device timebase)
+    uint32_t uncertaintyUs; // Of errorUs, PCF8523_PRECISE_UNKNOWN_US if it was not measured
+} pcf8523_SyncReport_t;
+
+typedef struct {
+    uint8_t round; // Sequence number of the last request
+    bool pending;  // The last request is still unanswered
+    uint64_t requestUs;
+
+    bool valid; // At least one round was answered
+    uint8_t rounds;
+    int64_t offsetUs;
+    uint32_t delayUs;
+    uint32_t maxDelayUs;
+} pcf8523_Sync_t;
+
+bool pcf8523_sync_init(pcf8523_Sync_t *sync);
+
+/**
+ * @brief Sends the next request, stamped with nowUs (device clock), and flushes it
+ *
+ * Records still pending in the encoder would leave in the same frame and delay the request
+ * against its stamp, so they should be flushed before nowUs is taken.
+ */
+bool pcf8523_sync_request(pcf8523_Sync_t *sync, pcf8523_TelemetryEncoder_t *enc, uint64_t nowUs);
+
+/**
+ * @brief Accounts a decoded record, true if it was the answer to the pending request
+ *
+ * @param receiveUs Device clock when the bytes holding the record were read
+ */
+bool pcf8523_sync_handle(pcf8523_Sync_t *sync, const pcf8523_TelemetryRecord_t *record,
+                         uint64_t receiveUs);
+
+/**
+ * @brief Adds one round, keeping it if its delay is the smallest so far
+ */
+bool pcf8523_sync_add_round(pcf8523_Sync_t *sync, uint64_t t1, uint64_t t2, uint64_t t3,
+                            uint64_t t4);
+
+/**
+ * @brief First whole host second at least leadUs after nowUs, in both timebases
+ *
+ * @param boundaryUs Device clock at which the host clock reaches epoch.000000
+ */
+bool pcf8523_sync_next_boundary(const pcf8523_Sync_t *sync, uint64_t nowUs, uint32_t leadUs,
+                                uint64_t *boundaryUs, uint32_t *epoch);
+
+bool pcf8523_sync_parse_request(const pcf8523_TelemetryRecord_t *record, uint8_t *round,
+                                uint64_t *requestUs);
+
+/**
+ * @brief Host side answer, transmitUs is taken right before the call (with the encoder empty)
+ */
+bool pcf8523_sync_send_response(pcf8523_TelemetryEncoder_t *enc, uint8_t round,
+                                uint64_t requestUs, uint64_t receiveUs, uint64_t transmitUs);
+
+bool pcf8523_sync_send_report(pcf8523_TelemetryEncoder_t *enc, const pcf8523_SyncReport_t *report);
+
+bool pcf8523_sync_parse_report(const pcf8523_TelemetryRecord_t *record,
+                               pcf8523_SyncReport_t *report);
+
+#ifndef PCF8523_HOST_BUILD
+/**
+ * @brief Non-blocking read of the bytes received so far, returns how many were copied
+ */
+typedef size_t (*pcf8523_SyncSource_t)(void *ctx, uint8_t *data, size_t len);
+
+/**
+ * @brief Runs the rounds, sets the RTC on the next host second boundary and sends the report
+ *
+ * Blocks for the rounds (up to PCF8523_SYNC_ROUND_TIMEOUT_US each) and 0.5 s to 1.5 s more for
+ * the precise set. Fails without touching the RTC when no round was answered. The transport
+ * has the same requirements as for pcf8523_set_datetime_precise (see pcf8523_precise.h).
+ *
+ * @param report Optional, filled with what was sent to the host
+ */
+bool pcf8523_sync_run(pcf8523_Sync_t *sync, pcf8523_t *pcf8523, pcf8523_TelemetryEncoder_t *enc,
+                      pcf8523_SyncSource_t source, void *sourceCtx, uint8_t rounds,
+                      pcf8523_SyncReport_t *report);
+#endif
+#endif
@@ -0,0 +1,135 @@
+/**
+ * @file pcf8523_tcomp.h
+ * @brief Temperature compensation of the crystal through the offset register
+ *
+ * A tuning fork crystal runs slower the further it is from its turnover temperature, following a
+ * parabola (about -0.035 ppm/°C²). pcf8523_tcomp_update turns a temperature sample into the
+ * expected deviation, either from that curve or from a table of measured points, and from there
+ * into the offset register value that cancels it. The register is only written when the rounded
+ * correction moves by at least one step past a small hysteresis, and never more often than the
+ * configured interval.
+ *
+ * The correction applied over time is integrated, so the total compensation (in ns) is known and
+ * every write can be reported to a callback, for example to append it to a pcf8523_Log_t.
+ *
+ * The module does not read the temperature itself: on the Pico pcf8523_tcomp_read_temp_adc samples
+ * the on-die sensor, while a host can feed a simulated trace.
+ *
+ * Deviations are in ppb and positive when the crystal runs fast.
+ *
+ * @author ljn0099
+ *
+ * @license MIT License
+ * Copyright (c) 2025 ljn0099
+ *
+ * See LICENSE file for details.
+ */
+#ifndef PCF8523_TCOMP_H
+#define PCF8523_TCOMP_H
+
+#include "sensor/pcf8523.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define PCF8523_TCOMP_STEP_2H_PPB 4340  // Offset step in PCF8523_OFFSET_EVERY_2_HOURS mode
+#define PCF8523_TCOMP_STEP_MIN_PPB 4069 // Offset step in PCF8523_OFFSET_EVERY_MIN mode
+#define PCF8523_TCOMP_HYSTERESIS 250    // Thousandths of a step past the rounding point
+#define PCF8523_TCOMP_FILTER_SHIFT 3    // Temperature low pass, 1/8 of every new sample
+#define PCF8523_TCOMP_LEARN_SHIFT 2     // Table learning, 1/4 of every new measurement
+
+#define PCF8523_TCOMP_TURNOVER_MC 25000
+#define PCF8523_TCOMP_PARABOLIC_PPB -35 // ppb/°C²
+
+typedef struct {
+    int32_t tempMilliC;
+    int32_t deviationPpb;
+} pcf8523_TcompPoint_t;
+
+typedef struct {
+    pcf8523_OffsetMode_t mode;
+    uint32_t minIntervalMs; // Between two writes of the offset register
+
+    // Turnover curve: deviation = staticPpb + parabolicPpb * (T - turnover)²
+    int32_t turnoverMilliC;
+    int32_t parabolicPpb;
+    int32_t staticPpb;
+
+    // When set, the table (sorted by temperature) replaces the curve, linearly interpolated and
+    // clamped at both ends
+    const pcf8523_TcompPoint_t *table;
+    uint8_t tableSize;
+} pcf8523_TcompConfig_t;
+
+typedef struct {
+    int32_t tempMilliC; // Filtered temperature
+    int32_t deviationPpb;
+    int8_t offset; // Value written
+    int64_t correctionNs;
+    uint32_t writes;
+} pcf8523_TcompRecord_t;
+
+typedef void (*pcf8523_TcompLog_t)(void *ctx, const pcf8523_TcompRecord_t *record);
+
+typedef struct {
+    pcf8523_t *pcf8523;
+    pcf8523_TcompConfig_t config;
+    pcf8523_TcompLog_t log;
+    void *logCtx;
+
+    bool started;
+    bool synced; // The register holds config.mode and offset
+    int32_t tempMilliC;
+    int32_t deviationPpb;
+    int8_t offset;
+    uint32_t lastUpdateMs;
+    uint32_t lastWriteMs;
+
+    int64_t correctionNs; // Integral of the applied correction, positive when time was added
+    int64_t correctionRem;
+    uint32_t writes;
+    uint32_t deferred; // Updates that needed a write inside the rate limit
+} pcf8523_Tcomp_t;
+
+/**
+ * @brief Default configuration: parabolic curve, 2 hour mode, one write per 10 minutes at most
+ */
+void pcf8523_tcomp_default_config(pcf8523_TcompConfig_t *config);
+
+/**
+ * @brief Reads the current offset register so the first update does not rewrite it needlessly
+ */
+bool pcf8523_tcomp_init(pcf8523_Tcomp_t *tc, pcf8523_t *pcf8523,
+                        const pcf8523_TcompConfig_t *config, pcf8523_TcompLog_t log, void *logCtx);
+
+int32_t pcf8523_tcomp_deviation_ppb(const pcf8523_TcompConfig_t *config, int32_t tempMilliC);
+
+/**
+ * @brief Moves the table point closest to tempMilliC towards a measured deviation
+ *
+ * The measurement usually comes from comparing the RTC against a reference (NTP, GPS) over a
+ * period with stable temperature, measured with the offset register at 0 or with the applied
+ * correction added back.
+ */
+bool pcf8523_tcomp_learn(pcf8523_TcompPoint_t *table, uint8_t tableSize, int32_t tempMilliC,
+                         int32_t measuredPpb);
+
+/**
+ * @brief Feeds one temperature sample, nowMs is any free running millisecond counter
+ *
+ * @return false only if the bus access failed
+ */
+bool pcf8523_tcomp_update(pcf8523_Tcomp_t *tc, int32_t tempMilliC, uint32_t nowMs);
+
+#ifndef PCF8523_HOST_BUILD
+/**
+ * @brief Enables the ADC and its temperature sensor
+ */
+void pcf8523_tcomp_adc_init(void);
+
+/**
+ * @brief Averaged reading of the on-die temperature sensor in m°C
+ */
+int32_t pcf8523_tcomp_read_temp_adc(void);
+#endif
+#endif
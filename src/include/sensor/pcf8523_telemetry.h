@@ -0,0 +1,141 @@
+/**
+ * @file pcf8523_telemetry.h
+ * @brief Binary telemetry frames (COBS + CRC16) for time samples, register snapshots and events
+ *
+ * Records are batched into frames: a 16 bit sequence number, the records (type, length, body, all
+ * little endian) and a CRC16-CCITT of everything before it. The frame is COBS encoded and closed
+ * with a 0x00 byte, so a receiver can join the stream at any point and resynchronise on the next
+ * delimiter. A frame holds up to PCF8523_TELEMETRY_MAX_RECORDS_SIZE bytes of records and costs 6
+ * bytes of overhead, a time sample is 12 bytes where the equivalent printf line is about 40.
+ *
+ * The encoder flushes a frame to the sink when the next record would not fit, or on
+ * pcf8523_telemetry_flush (for example once per period, to bound the latency). The decoder is a
+ * streaming state machine fed with whatever chunks the link delivers, it copies the runs between
+ * COBS code bytes in blocks and hands every record of a valid frame to a callback. Lost frames are
+ * counted from gaps in the sequence numbers.
+ *
+ * @author ljn0099
+ *
+ * @license MIT License
+ * Copyright (c) 2025 ljn0099
+ *
+ * See LICENSE file for details.
+ */
+#ifndef PCF8523_TELEMETRY_H
+#define PCF8523_TELEMETRY_H
+
+#include "sensor/pcf8523.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define PCF8523_TELEMETRY_MAX_FRAME 254 // Raw frame, so COBS needs a single code byte
+#define PCF8523_TELEMETRY_MAX_RECORDS_SIZE (PCF8523_TELEMETRY_MAX_FRAME - 4)
+#define PCF8523_TELEMETRY_MAX_BODY (PCF8523_TELEMETRY_MAX_RECORDS_SIZE - 2)
+#define PCF8523_TELEMETRY_MAX_ENCODED (PCF8523_TELEMETRY_MAX_FRAME + 2) // Code byte and delimiter
+
+typedef enum {
+    PCF8523_TELEMETRY_TIME = 1,      // epoch u32, clockUs u32, health u16
+    PCF8523_TELEMETRY_REGISTERS = 2, // clockUs u32, registers 0x00..0x13
+    PCF8523_TELEMETRY_EVENT = 3,     // clockUs u32, code u16, arg u32
+
+    // Time synchronisation messages, see pcf8523_sync.h
+    PCF8523_TELEMETRY_SYNC_REQUEST = 16,
+    PCF8523_TELEMETRY_SYNC_RESPONSE = 17,
+    PCF8523_TELEMETRY_SYNC_REPORT = 18
+} pcf8523_TelemetryType_t;
+
+typedef void (*pcf8523_TelemetrySink_t)(void *ctx, const uint8_t *data, size_t len);
+
+typedef struct {
+    uint8_t type;
+    uint8_t len;
+    const uint8_t *body;
+    uint16_t frameSeq;
+} pcf8523_TelemetryRecord_t;
+
+typedef void (*pcf8523_TelemetryHandler_t)(void *ctx, const pcf8523_TelemetryRecord_t *record);
+
+typedef struct {
+    pcf8523_TelemetrySink_t sink;
+    void *ctx;
+
+    uint8_t frame[PCF8523_TELEMETRY_MAX_FRAME];
+    size_t len;
+    uint16_t seq;
+
+    uint32_t frames;
+    uint32_t records;
+    uint32_t bytes; // Encoded bytes handed to the sink
+} pcf8523_TelemetryEncoder_t;
+
+typedef struct {
+    pcf8523_TelemetryHandler_t handler;
+    void *ctx;
+
+    uint8_t frame[PCF8523_TELEMETRY_MAX_FRAME];
+    size_t len;
+    uint8_t remaining; // Data bytes left in the current COBS block
+    bool zeroPending;  // The block ended before the maximum length, a 0x00 follows it
+    bool overflow;     // Frame longer than the maximum, dropped at the delimiter
+
+    bool synced; // nextSeq is valid
+    uint16_t nextSeq;
+
+    uint32_t frames;
+    uint32_t records;
+    uint32_t crcErrors;
+    uint32_t malformed; // Bad length, record layout or COBS structure
+    uint32_t lostFrames;
+} pcf8523_TelemetryDecoder_t;
+
+bool pcf8523_telemetry_encoder_init(pcf8523_TelemetryEncoder_t *enc, pcf8523_TelemetrySink_t sink,
+                                    void *ctx);
+
+/**
+ * @brief Appends a record, the current frame is flushed first if it would not fit
+ */
+bool pcf8523_telemetry_add(pcf8523_TelemetryEncoder_t *enc, uint8_t type, const uint8_t *body,
+                           uint8_t len);
+
+bool pcf8523_telemetry_add_time(pcf8523_TelemetryEncoder_t *enc, uint32_t epoch, uint32_t clockUs,
+                                uint16_t health);
+
+bool pcf8523_telemetry_add_event(pcf8523_TelemetryEncoder_t *enc, uint32_t clockUs, uint16_t code,
+                                 uint32_t arg);
+
+/**
+ * @brief Reads the time and health in one transfer and appends it as a time record
+ */
+bool pcf8523_telemetry_sample_time(pcf8523_TelemetryEncoder_t *enc, pcf8523_t *pcf8523,
+                                   uint16_t century, uint32_t clockUs);
+
+/**
+ * @brief Reads all the registers in one transfer and appends them as a snapshot
+ */
+bool pcf8523_telemetry_sample_registers(pcf8523_TelemetryEncoder_t *enc, pcf8523_t *pcf8523,
+                                        uint32_t clockUs);
+
+/**
+ * @brief Encodes the pending records (if any) and hands the frame to the sink
+ */
+bool pcf8523_telemetry_flush(pcf8523_TelemetryEncoder_t *enc);
+
+bool pcf8523_telemetry_decoder_init(pcf8523_TelemetryDecoder_t *dec,
+                                    pcf8523_TelemetryHandler_t handler, void *ctx);
+
+/**
+ * @brief Feeds received bytes, records of every complete valid frame go to the handler
+ */
+void pcf8523_telemetry_decode(pcf8523_TelemetryDecoder_t *dec, const uint8_t *data, size_t len);
+
+bool pcf8523_telemetry_parse_time(const pcf8523_TelemetryRecord_t *record, uint32_t *epoch,
+                                  uint32_t *clockUs, uint16_t *health);
+
+bool pcf8523_telemetry_parse_registers(const pcf8523_TelemetryRecord_t *record, uint32_t *clockUs,
+                                       uint8_t *registers);
+
+bool pcf8523_telemetry_parse_event(const pcf8523_TelemetryRecord_t *record, uint32_t *clockUs,
+                                   uint16_t *code, uint32_t *arg);
+#endif
@@ -0,0 +1,81 @@
+/**
+ * @file pcf8523_tick.h
+ * @brief Periodic tick engine driven by the PCF8523 second interrupt or Timer B
+ *
+ * The RTC generates pulsed interrupts on INT1 (1 Hz from the second interrupt, or a Timer B period
+ * from the 4096 Hz / 64 Hz / 1 Hz source), so periodic work is phase locked to the crystal. The
+ * INT1 falling edge only bumps a counter: pcf8523_tick_handle_irq has to be called from the
+ * application GPIO callback. pcf8523_tick_poll then runs the due callbacks from a hashed timing
+ * wheel and keeps per task jitter and overrun statistics. No bus access happens per tick.
+ *
+ * @author ljn0099
+ *
+ * @license MIT License
+ * Copyright (c) 2025 ljn0099
+ *
+ * See LICENSE file for details.
+ */
+#ifndef PCF8523_TICK_H
+#define PCF8523_TICK_H
+
+#include "sensor/pcf8523.h"
+
+#define PCF8523_TICK_MAX_TASKS 16
+#define PCF8523_TICK_WHEEL_SIZE 32
+#define PCF8523_TICK_NO_TASK 0xFF
+
+typedef void (*pcf8523_TickCallback_t)(void *userData);
+
+typedef enum { PCF8523_TICK_SOURCE_SECOND = 0, PCF8523_TICK_SOURCE_TIMER_B } pcf8523_TickSource_t;
+
+typedef struct {
+    uint32_t runs;
+    uint32_t overruns;  // Runs started one tick or more after they were due
+    int64_t minJitterUs; // Deviation of the measured interval from the nominal period
+    int64_t maxJitterUs;
+    uint32_t maxLatencyUs; // From the INT1 edge to the callback
+} pcf8523_TickStats_t;
+
+typedef struct {
+    pcf8523_TickCallback_t callback;
+    void *userData;
+    uint32_t periodTicks;
+    uint32_t dueTick;
+    uint8_t next;
+
+    uint64_t lastRunUs;
+    pcf8523_TickStats_t stats;
+} pcf8523_TickTask_t;
+
+typedef struct {
+    pcf8523_t *pcf8523;
+    pcf8523_TickSource_t source;
+    uint64_t tickNs;
+
+    volatile uint32_t irqTicks;
+    volatile uint32_t lastEdgeUs;
+
+    uint32_t tick;
+    uint32_t lateTicks;
+    uint8_t taskCount;
+    uint8_t wheel[PCF8523_TICK_WHEEL_SIZE];
+    pcf8523_TickTask_t tasks[PCF8523_TICK_MAX_TASKS];
+} pcf8523_TickEngine_t;
+
+bool pcf8523_tick_start_second(pcf8523_TickEngine_t *engine, pcf8523_t *pcf8523);
+
+bool pcf8523_tick_start_timer_b(pcf8523_TickEngine_t *engine, pcf8523_t *pcf8523,
+                                pcf8523_ClkSourceFreq_t sourceFreq, uint8_t value);
+
+bool pcf8523_tick_stop(pcf8523_TickEngine_t *engine);
+
+bool pcf8523_tick_add(pcf8523_TickEngine_t *engine, uint32_t periodTicks,
+                      pcf8523_TickCallback_t callback, void *userData, uint8_t *id);
+
+void pcf8523_tick_handle_irq(pcf8523_TickEngine_t *engine);
+
+uint32_t pcf8523_tick_poll(pcf8523_TickEngine_t *engine);
+
+bool pcf8523_tick_read_stats(const pcf8523_TickEngine_t *engine, uint8_t id,
+                             pcf8523_TickStats_t *stats);
+#endif
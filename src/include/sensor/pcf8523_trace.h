@@ -0,0 +1,101 @@
+/**
+ * @file pcf8523_trace.h
+ * @brief Binary trace of the bus transfers in a RAM ring, for field debugging and offline replay
+ *
+ * pcf8523_trace_init wraps the transport of a pcf8523_t, so every transfer made by the driver
+ * (pcf8523_read_register, pcf8523_write_block, pcf8523_execute, ...) is appended as a compact
+ * record: timestamp, duration, address, direction, start register, payload and result. When the
+ * ring is full the oldest records are dropped.
+ *
+ * pcf8523_trace_dump streams a header and the records, oldest first, to any byte sink (for example
+ * uart_write_blocking). pcf8523_trace_parse decodes the same stream, the trace_replay host tool
+ * uses it to list, replay and compare captures.
+ *
+ * Stream layout, little endian: "PTRC", version (1 byte), record count (4 bytes), dropped records
+ * (4 bytes), then the records: flags (1 byte), address, start register, payload length,
+ * timestamp in us (4 bytes), duration in us (2 bytes, saturated), payload.
+ *
+ * The recorder is not interrupt safe, dumping has to happen from the context using the driver.
+ *
+ * @author ljn0099
+ *
+ * @license MIT License
+ * Copyright (c) 2025 ljn0099
+ *
+ * See LICENSE file for details.
+ */
+#ifndef PCF8523_TRACE_H
+#define PCF8523_TRACE_H
+
+#include "sensor/pcf8523.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define PCF8523_TRACE_VERSION 1
+#define PCF8523_TRACE_HEADER_SIZE 13
+#define PCF8523_TRACE_RECORD_OVERHEAD 10
+#define PCF8523_TRACE_MAX_PAYLOAD 32 // Longer transfers are truncated
+
+#define PCF8523_TRACE_FLAG_WRITE (1 << 0)
+#define PCF8523_TRACE_FLAG_OK (1 << 1)
+#define PCF8523_TRACE_FLAG_TRUNCATED (1 << 2)
+
+typedef uint32_t (*pcf8523_TraceClock_t)(void);
+
+typedef void (*pcf8523_TraceSink_t)(void *ctx, const uint8_t *data, size_t len);
+
+typedef struct {
+    uint32_t timestampUs;
+    uint16_t durationUs;
+    uint8_t flags;
+    uint8_t i2cAddress;
+    uint8_t reg;
+    uint8_t len;
+    uint8_t payload[PCF8523_TRACE_MAX_PAYLOAD];
+} pcf8523_TraceRecord_t;
+
+typedef struct {
+    const pcf8523_Transport_t *transport; // Wrapped transport
+    void *transportCtx;
+    pcf8523_TraceClock_t clock;
+
+    uint8_t *buffer;
+    size_t size;
+    size_t head;
+    size_t used;
+
+    bool enabled;
+    uint32_t records;
+    uint32_t dropped;
+} pcf8523_Trace_t;
+
+/**
+ * @brief Starts recording the transfers of pcf8523
+ *
+ * @param clock Microsecond time source (time_us_32 on the Pico), NULL stores zero timestamps
+ */
+bool pcf8523_trace_init(pcf8523_Trace_t *trace, pcf8523_t *pcf8523, uint8_t *buffer, size_t size,
+                        pcf8523_TraceClock_t clock);
+
+void pcf8523_trace_enable(pcf8523_Trace_t *trace, bool enabled);
+
+void pcf8523_trace_clear(pcf8523_Trace_t *trace);
+
+bool pcf8523_trace_dump(const pcf8523_Trace_t *trace, pcf8523_TraceSink_t sink, void *ctx);
+
+/**
+ * @brief Finds and decodes the stream header, anything before the magic is skipped
+ *
+ * @param pos Set to the first record
+ */
+bool pcf8523_trace_parse_header(const uint8_t *data, size_t len, size_t *pos, uint32_t *records,
+                                uint32_t *dropped);
+
+/**
+ * @brief Decodes the record at pos and moves pos past it
+ */
+bool pcf8523_trace_parse(const uint8_t *data, size_t len, size_t *pos,
+                         pcf8523_TraceRecord_t *record);
+#endif
@@ -0,0 +1,73 @@
+/**
+ * @file pcf8523_tstream.h
+ * @brief Compact delta-of-delta timestamp stream for PCF8523 epochs
+ *
+ * Every sample is written as one LEB128 varint token. The lowest bit of the token tells both kinds
+ * apart:
+ * - keyframe: (epoch << 1) | 1, the absolute epoch, resets the running delta to 0
+ * - sample:   zigzag(delta - previous delta) << 1
+ *
+ * A buffer always starts with a keyframe and a new one is emitted every keyframeInterval samples.
+ * Since varint boundaries can be found from any byte (the previous byte has bit 7 clear) and the
+ * first byte of a token carries the keyframe bit, a decoder can resynchronise on the next keyframe
+ * from any offset, which is what pcf8523_tstream_seek uses for random access.
+ *
+ * Evenly spaced samples cost a single byte each.
+ *
+ * @author ljn0099
+ *
+ * @license MIT License
+ * Copyright (c) 2025 ljn0099
+ *
+ * See LICENSE file for details.
+ */
+#ifndef PCF8523_TSTREAM_H
+#define PCF8523_TSTREAM_H
+
+#include "sensor/pcf8523.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define PCF8523_TSTREAM_MAX_TOKEN_SIZE 10
+
+typedef struct {
+    uint8_t *buffer;
+    size_t capacity;
+    size_t length;
+
+    uint16_t keyframeInterval;
+    uint16_t sinceKeyframe;
+    uint64_t prevEpoch;
+    int64_t prevDelta;
+} pcf8523_TstreamEncoder_t;
+
+typedef struct {
+    const uint8_t *data;
+    size_t length;
+    size_t pos;
+
+    bool synced;
+    uint64_t prevEpoch;
+    int64_t prevDelta;
+} pcf8523_TstreamDecoder_t;
+
+bool pcf8523_tstream_encoder_init(pcf8523_TstreamEncoder_t *enc, uint8_t *buffer, size_t capacity,
+                                  uint16_t keyframeInterval);
+
+void pcf8523_tstream_encoder_reset(pcf8523_TstreamEncoder_t *enc);
+
+bool pcf8523_tstream_encode(pcf8523_TstreamEncoder_t *enc, uint64_t epoch);
+
+bool pcf8523_tstream_encode_datetime(pcf8523_TstreamEncoder_t *enc, const pcf8523_Datetime_t *dt,
+                                     uint16_t century);
+
+bool pcf8523_tstream_decoder_init(pcf8523_TstreamDecoder_t *dec, const uint8_t *data,
+                                  size_t length);
+
+bool pcf8523_tstream_decode(pcf8523_TstreamDecoder_t *dec, uint64_t *epochs, size_t maxEpochs,
+                            size_t *count);
+
+bool pcf8523_tstream_seek(pcf8523_TstreamDecoder_t *dec, uint64_t epoch);
+#endif
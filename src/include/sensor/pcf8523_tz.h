@@ -0,0 +1,54 @@
+/**
+ * @file pcf8523_tz.h
+ * @brief Timezone and DST conversion for the PCF8523 datetime
+ *
+ * A POSIX TZ rule string (for example "CET-1CEST,M3.5.0,M10.5.0/3") is expanded once into a sorted
+ * table of UTC transition instants covering 2000-2099, the range of the RTC. Conversions then only
+ * need a binary search, and the interval used last is cached so consecutive conversions around the
+ * current time are O(1).
+ *
+ * This allows keeping the RTC in UTC and converting to local time only for display or scheduling.
+ *
+ * @author ljn0099
+ *
+ * @license MIT License
+ * Copyright (c) 2025 ljn0099
+ *
+ * See LICENSE file for details.
+ */
+#ifndef PCF8523_TZ_H
+#define PCF8523_TZ_H
+
+#include "sensor/pcf8523.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define PCF8523_TZ_FIRST_YEAR 2000
+#define PCF8523_TZ_LAST_YEAR 2099
+#define PCF8523_TZ_MAX_TRANSITIONS (2 * (PCF8523_TZ_LAST_YEAR - PCF8523_TZ_FIRST_YEAR + 1))
+
+typedef struct {
+    uint32_t utc;   // Transition instant as UTC epoch
+    int32_t offset; // Seconds to add to UTC from this instant on
+    bool isDst;
+} pcf8523_TzTransition_t;
+
+typedef struct {
+    pcf8523_TzTransition_t transitions[PCF8523_TZ_MAX_TRANSITIONS];
+    uint16_t count;
+    int32_t initialOffset; // Offset before the first transition
+    bool initialIsDst;
+    uint16_t cached; // Interval of the last lookup, transitions[cached - 1] starts it
+} pcf8523_Tz_t;
+
+bool pcf8523_tz_init(pcf8523_Tz_t *tz, const char *posixTz);
+
+int32_t pcf8523_tz_offset_at(pcf8523_Tz_t *tz, uint64_t utcEpoch, bool *isDst);
+
+bool pcf8523_tz_utc_to_local(pcf8523_Tz_t *tz, uint64_t utcEpoch, pcf8523_Datetime_t *local,
+                             bool *isDst);
+
+bool pcf8523_tz_local_to_utc(pcf8523_Tz_t *tz, const pcf8523_Datetime_t *local, uint16_t century,
+                             uint64_t *utcEpoch);
+#endif
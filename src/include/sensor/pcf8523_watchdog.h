@@ -0,0 +1,51 @@
+/**
+ * @file pcf8523_watchdog.h
+ * @brief External watchdog supervisor built on the PCF8523 Timer A watchdog mode
+ *
+ * The remaining watchdog budget is tracked locally against time_us_64(), so the timer is only
+ * reloaded (one register write) once the budget drops below a threshold instead of on every loop
+ * iteration. Tasks register liveness tokens and the watchdog is only kicked after all of them have
+ * checked in since the previous kick, so a hung task lets the timer expire.
+ *
+ * @author ljn0099
+ *
+ * @license MIT License
+ * Copyright (c) 2025 ljn0099
+ *
+ * See LICENSE file for details.
+ */
+#ifndef PCF8523_WATCHDOG_H
+#define PCF8523_WATCHDOG_H
+
+#include "sensor/pcf8523.h"
+
+#define PCF8523_WATCHDOG_MAX_TOKENS 8
+
+typedef struct {
+    pcf8523_t *pcf8523;
+    pcf8523_TimerAValue period;
+    uint64_t budgetUs;    // Guaranteed time between reloads
+    uint64_t thresholdUs; // Reload when less than this remains
+    uint64_t lastKickUs;
+
+    uint8_t tokenCount;
+    volatile bool checkedIn[PCF8523_WATCHDOG_MAX_TOKENS];
+
+    int64_t minMarginUs;
+    uint32_t kicks;
+    uint32_t services;
+} pcf8523_Watchdog_t;
+
+bool pcf8523_watchdog_start(pcf8523_Watchdog_t *wdt, pcf8523_t *pcf8523,
+                            const pcf8523_TimerAValue *period, uint32_t thresholdUs);
+
+bool pcf8523_watchdog_stop(pcf8523_Watchdog_t *wdt);
+
+bool pcf8523_watchdog_register_token(pcf8523_Watchdog_t *wdt, uint8_t *token);
+
+void pcf8523_watchdog_checkin(pcf8523_Watchdog_t *wdt, uint8_t token);
+
+bool pcf8523_watchdog_service(pcf8523_Watchdog_t *wdt);
+
+int64_t pcf8523_watchdog_remaining_us(const pcf8523_Watchdog_t *wdt);
+#endif
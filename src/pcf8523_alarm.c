@@ -0,0 +1,137 @@
+#include "pcf8523_private.h"
+#include "sensor/pcf8523.h"
+
+bool pcf8523_read_alarm(pcf8523_t *pcf8523, pcf8523_Alarm_t *alarm) {
+    if (!pcf8523 || !alarm)
+        return false;
+
+    uint8_t buffer[4];
+
+    if (!pcf8523_read_block(pcf8523, PCF8523_MINUTES_ALARM_REG, buffer, 4))
+        return false;
+
+    alarm->hourMode =
+        pcf8523_extract_hour_mode(&buffer[PCF8523_HOUR_ALARM], PCF8523_FORMAT_24H(pcf8523));
+
+    alarm->enableMinAlarm = true;
+    alarm->enableHourAlarm = true;
+    alarm->enableDayAlarm = true;
+    alarm->enableWeekDayAlarm = true;
+
+    if (buffer[PCF8523_MIN_ALARM] & PCF8523_DISABLE_ALARM_MASK) {
+        alarm->enableMinAlarm = false;
+        buffer[PCF8523_MIN_ALARM] &= (uint8_t)(~PCF8523_DISABLE_ALARM_MASK);
+    }
+    if (buffer[PCF8523_HOUR_ALARM] & PCF8523_DISABLE_ALARM_MASK) {
+        alarm->enableHourAlarm = false;
+        buffer[PCF8523_HOUR_ALARM] &= (uint8_t)(~PCF8523_DISABLE_ALARM_MASK);
+    }
+    if (buffer[PCF8523_DAY_ALARM] & PCF8523_DISABLE_ALARM_MASK) {
+        alarm->enableDayAlarm = false;
+        buffer[PCF8523_DAY_ALARM] &= (uint8_t)(~PCF8523_DISABLE_ALARM_MASK);
+    }
+    if (buffer[PCF8523_WEEKDAY_ALARM] & PCF8523_DISABLE_ALARM_MASK) {
+        alarm->enableWeekDayAlarm = false;
+        buffer[PCF8523_WEEKDAY_ALARM] &= (uint8_t)(~PCF8523_DISABLE_ALARM_MASK);
+    }
+
+    alarm->minAlarm = pcf8523_bcd_to_decimal(buffer[PCF8523_MIN_ALARM]);
+    alarm->hourAlarm = pcf8523_bcd_to_decimal(buffer[PCF8523_HOUR_ALARM]);
+    alarm->dayAlarm = pcf8523_bcd_to_decimal(buffer[PCF8523_DAY_ALARM]);
+    alarm->weekDayAlarm = buffer[PCF8523_WEEKDAY_ALARM];
+
+    return true;
+}
+
+bool pcf8523_read_alarm_field(pcf8523_t *pcf8523, pcf8523_AlarmReg_t reg, uint8_t *value,
+                              bool *enabled, pcf8523_HourMode_t *hourMode) {
+    if (!pcf8523)
+        return false;
+
+    if (reg == PCF8523_HOURS_ALARM_REG && !hourMode)
+        return false;
+
+    uint8_t buffer;
+
+    if (!pcf8523_read_register(pcf8523, reg, &buffer))
+        return false;
+
+    if (reg == PCF8523_HOURS_ALARM_REG)
+        *hourMode = pcf8523_extract_hour_mode(&buffer, PCF8523_FORMAT_24H(pcf8523));
+
+    if (buffer & PCF8523_DISABLE_ALARM_MASK) {
+        if (enabled)
+            *enabled = false;
+        buffer &= (uint8_t)(~PCF8523_DISABLE_ALARM_MASK);
+    }
+    else if (enabled) {
+        *enabled = true;
+    }
+
+    if (reg != PCF8523_WEEKDAYS_ALARM_REG && value)
+        *value = pcf8523_bcd_to_decimal(buffer);
+
+    return true;
+}
+
+bool pcf8523_set_alarm(pcf8523_t *pcf8523, pcf8523_Alarm_t *alarm) {
+    if (!pcf8523 || !alarm)
+        return false;
+
+    if (!pcf8523_validate_alarm(alarm, PCF8523_FORMAT_24H(pcf8523)))
+        return false;
+
+    uint8_t frame[PCF8523_FRAME_SIZE(4)];
+    pcf8523_Transaction_t tx;
+    if (!pcf8523_transaction_init(&tx, PCF8523_MINUTES_ALARM_REG, frame, 4, true))
+        return false;
+    uint8_t *buffer = pcf8523_transaction_data(&tx);
+
+    buffer[PCF8523_MIN_ALARM] = pcf8523_decimal_to_bcd(alarm->minAlarm);
+    buffer[PCF8523_HOUR_ALARM] = pcf8523_decimal_to_bcd(alarm->hourAlarm);
+    buffer[PCF8523_DAY_ALARM] = pcf8523_decimal_to_bcd(alarm->dayAlarm);
+    buffer[PCF8523_WEEKDAY_ALARM] = alarm->weekDayAlarm;
+
+    if (!alarm->enableMinAlarm)
+        buffer[PCF8523_MIN_ALARM] |= PCF8523_DISABLE_ALARM_MASK;
+    if (!alarm->enableHourAlarm)
+        buffer[PCF8523_HOUR_ALARM] |= PCF8523_DISABLE_ALARM_MASK;
+    if (!alarm->enableDayAlarm)
+        buffer[PCF8523_DAY_ALARM] |= PCF8523_DISABLE_ALARM_MASK;
+    if (!alarm->enableWeekDayAlarm)
+        buffer[PCF8523_WEEKDAY_ALARM] |= PCF8523_DISABLE_ALARM_MASK;
+
+    if (alarm->hourMode == PCF8523_HOUR_MODE_PM)
+        buffer[PCF8523_HOUR_ALARM] |= PCF8523_HOUR_PM_MASK;
+
+    if (!pcf8523_execute(pcf8523, &tx))
+        return false;
+
+    return true;
+}
+
+bool pcf8523_set_alarm_field(pcf8523_t *pcf8523, pcf8523_AlarmReg_t reg, uint8_t value, bool enable,
+                             pcf8523_HourMode_t *hourMode) {
+    if (!pcf8523)
+        return false;
+
+    if (!hourMode && reg == PCF8523_HOURS_ALARM_REG)
+        return false;
+
+    if (!pcf8523_validate_time_field(reg, value, hourMode, PCF8523_FORMAT_24H(pcf8523)))
+        return false;
+
+    if (reg != PCF8523_WEEKDAYS_ALARM_REG)
+        value = pcf8523_decimal_to_bcd(value);
+
+    if (reg == PCF8523_HOURS_ALARM_REG && *hourMode == PCF8523_HOUR_MODE_PM)
+        value |= PCF8523_HOUR_PM_MASK;
+
+    if (!enable)
+        value |= PCF8523_DISABLE_ALARM_MASK;
+
+    if (!pcf8523_write_register(pcf8523, reg, value))
+        return false;
+
+    return true;
+}
@@ -0,0 +1,194 @@
+#include "sensor/pcf8523_bus_tuner.h"
+#include "hardware/i2c.h"
+#include "pcf8523_private.h"
+#include "sensor/pcf8523.h"
+
+#define PCF8523_BUS_TUNER_IMAGE_START PCF8523_MINUTES_ALARM_REG
+#define PCF8523_BUS_TUNER_IMAGE_LEN (PCF8523_REGISTER_COUNT - PCF8523_MINUTES_ALARM_REG)
+
+static const uint32_t pcf8523BusTunerSteps[] = {100000, 200000, 400000, 600000, 800000, 1000000};
+
+#define PCF8523_BUS_TUNER_STEP_COUNT                                                              \
+    (uint8_t)(sizeof(pcf8523BusTunerSteps) / sizeof(pcf8523BusTunerSteps[0]))
+
+static void pcf8523_bus_tuner_set_level(pcf8523_BusTuner_t *tuner, uint8_t level) {
+    tuner->level = level;
+    tuner->baudrate = i2c_set_baudrate(tuner->pcf8523->i2c, pcf8523BusTunerSteps[level]);
+}
+
+static bool pcf8523_bus_tuner_record(pcf8523_BusTuner_t *tuner, bool ok) {
+    tuner->transfers++;
+    tuner->windowTransfers++;
+
+    if (!ok) {
+        tuner->errors++;
+        tuner->windowErrors++;
+    }
+
+    bool fallback = false;
+    if (tuner->windowErrors >= tuner->errorThreshold && tuner->level > 0) {
+        pcf8523_bus_tuner_set_level(tuner, (uint8_t)(tuner->level - 1));
+        tuner->fallbacks++;
+        fallback = true;
+    }
+
+    if (fallback || tuner->windowTransfers >= PCF8523_BUS_TUNER_ERROR_WINDOW) {
+        tuner->windowTransfers = 0;
+        tuner->windowErrors = 0;
+    }
+
+    return fallback;
+}
+
+static bool pcf8523_bus_tuner_read(void *ctx, uint8_t i2cAddress, uint8_t startReg, uint8_t *data,
+                                   size_t len) {
+    pcf8523_BusTuner_t *tuner = (pcf8523_BusTuner_t *)ctx;
+
+    bool ok = tuner->transport->read(tuner->transportCtx, i2cAddress, startReg, data, len);
+
+    // The failed transfer is retried once at the lower speed
+    if (pcf8523_bus_tuner_record(tuner, ok) && !ok)
+        ok = tuner->transport->read(tuner->transportCtx, i2cAddress, startReg, data, len);
+
+    return ok;
+}
+
+static bool pcf8523_bus_tuner_write(void *ctx, uint8_t i2cAddress, const uint8_t *frame,
+                                    size_t frameLen) {
+    pcf8523_BusTuner_t *tuner = (pcf8523_BusTuner_t *)ctx;
+
+    bool ok = tuner->transport->write(tuner->transportCtx, i2cAddress, frame, frameLen);
+
+    if (pcf8523_bus_tuner_record(tuner, ok) && !ok)
+        ok = tuner->transport->write(tuner->transportCtx, i2cAddress, frame, frameLen);
+
+    return ok;
+}
+
+static const pcf8523_Transport_t pcf8523_bus_tuner_transport = {
+    .read = pcf8523_bus_tuner_read,
+    .write = pcf8523_bus_tuner_write,
+};
+
+bool pcf8523_bus_tuner_init(pcf8523_BusTuner_t *tuner, pcf8523_t *pcf8523, uint32_t maxBaudrate,
+                            uint32_t errorThreshold) {
+    if (!tuner || !pcf8523 || !pcf8523->i2c || errorThreshold == 0)
+        return false;
+
+    if (maxBaudrate < pcf8523BusTunerSteps[0])
+        return false;
+
+    tuner->pcf8523 = pcf8523;
+    tuner->transport = pcf8523->transport;
+    tuner->transportCtx = pcf8523->transportCtx;
+    tuner->errorThreshold = errorThreshold;
+    tuner->windowTransfers = 0;
+    tuner->windowErrors = 0;
+    tuner->transfers = 0;
+    tuner->errors = 0;
+    tuner->fallbacks = 0;
+
+    tuner->maxLevel = 0;
+    while (tuner->maxLevel + 1 < PCF8523_BUS_TUNER_STEP_COUNT &&
+           pcf8523BusTunerSteps[tuner->maxLevel + 1] <= maxBaudrate)
+        tuner->maxLevel++;
+
+    pcf8523_bus_tuner_set_level(tuner, 0);
+
+    pcf8523->transport = &pcf8523_bus_tuner_transport;
+    pcf8523->transportCtx = tuner;
+
+    return true;
+}
+
+static bool pcf8523_bus_tuner_raw_read(pcf8523_BusTuner_t *tuner, uint8_t reg, uint8_t *data,
+                                       size_t len) {
+    return tuner->transport->read(tuner->transportCtx, tuner->pcf8523->i2cAddress, reg, data, len);
+}
+
+static bool pcf8523_bus_tuner_raw_write(pcf8523_BusTuner_t *tuner, uint8_t reg, uint8_t value) {
+    uint8_t frame[2] = {reg, value};
+
+    return tuner->transport->write(tuner->transportCtx, tuner->pcf8523->i2cAddress, frame, 2);
+}
+
+static bool pcf8523_bus_tuner_verify(pcf8523_BusTuner_t *tuner, const uint8_t *reference,
+                                     bool patternTest) {
+    static const uint8_t patterns[] = {0x55, 0xAA, 0x00, 0xFF, 0x5A, 0xA5, 0x0F, 0xF0};
+    uint8_t image[PCF8523_BUS_TUNER_IMAGE_LEN];
+
+    for (uint8_t round = 0; round < PCF8523_BUS_TUNER_PROBE_ROUNDS; round++) {
+        if (!pcf8523_bus_tuner_raw_read(tuner, PCF8523_BUS_TUNER_IMAGE_START, image,
+                                        sizeof(image)))
+            return false;
+
+        // The timer value registers count down, everything else has to match
+        for (uint8_t i = 0; i < sizeof(image); i++) {
+            uint8_t reg = (uint8_t)(PCF8523_BUS_TUNER_IMAGE_START + i);
+            if (reg == PCF8523_TMR_A_REF || reg == PCF8523_TMR_B_REG)
+                continue;
+            if (image[i] != reference[i])
+                return false;
+        }
+
+        if (patternTest) {
+            uint8_t readBack;
+            uint8_t pattern = patterns[round % sizeof(patterns)];
+            if (!pcf8523_bus_tuner_raw_write(tuner, PCF8523_TMR_A_REF, pattern) ||
+                !pcf8523_bus_tuner_raw_read(tuner, PCF8523_TMR_A_REF, &readBack, 1) ||
+                readBack != pattern)
+                return false;
+        }
+    }
+
+    return true;
+}
+
+bool pcf8523_bus_tuner_probe(pcf8523_BusTuner_t *tuner) {
+    if (!tuner || !tuner->pcf8523)
+        return false;
+
+    uint8_t reference[PCF8523_BUS_TUNER_IMAGE_LEN];
+    uint8_t tmrCtrl;
+
+    pcf8523_bus_tuner_set_level(tuner, 0);
+
+    if (!pcf8523_bus_tuner_raw_read(tuner, PCF8523_BUS_TUNER_IMAGE_START, reference,
+                                    sizeof(reference)))
+        return false;
+
+    if (!pcf8523_bus_tuner_raw_read(tuner, PCF8523_TMR_CTRL_REG, &tmrCtrl, 1))
+        return false;
+
+    // Writing the Timer A value register would restart a running timer
+    uint8_t tmrAValue = reference[PCF8523_TMR_A_REF - PCF8523_BUS_TUNER_IMAGE_START];
+    bool patternTest = (tmrCtrl & PCF8523_TMR_CTRL_TMR_A_MODE_MASK) == PCF8523_TMR_A_DISABLED;
+
+    // The pattern test is only kept if the register reads back at the safe speed
+    if (patternTest && !pcf8523_bus_tuner_verify(tuner, reference, true))
+        patternTest = false;
+
+    uint8_t selected = 0;
+    for (uint8_t level = 1; level <= tuner->maxLevel; level++) {
+        pcf8523_bus_tuner_set_level(tuner, level);
+        if (!pcf8523_bus_tuner_verify(tuner, reference, patternTest))
+            break;
+        selected = level;
+    }
+
+    pcf8523_bus_tuner_set_level(tuner, selected);
+    tuner->windowTransfers = 0;
+    tuner->windowErrors = 0;
+
+    if (patternTest && !pcf8523_bus_tuner_raw_write(tuner, PCF8523_TMR_A_REF, tmrAValue))
+        return false;
+
+    return true;
+}
+
+uint32_t pcf8523_bus_tuner_baudrate(const pcf8523_BusTuner_t *tuner) {
+    if (!tuner)
+        return 0;
+
+    return tuner->baudrate;
+}
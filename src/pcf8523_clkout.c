@@ -0,0 +1,36 @@
+#include "pcf8523_private.h"
+#include "sensor/pcf8523.h"
+
+bool pcf8523_set_clk_out_mode(pcf8523_t *pcf8523, pcf8523_ClkOutFreq_t clkOutFreq) {
+    if (!pcf8523)
+        return false;
+
+    uint8_t buffer;
+
+    if (!pcf8523_read_register(pcf8523, PCF8523_TMR_CTRL_REG, &buffer))
+        return false;
+
+    buffer &= (uint8_t)(~PCF8523_TMR_CTRL_CLKOUT_FREQ_MASK);
+    buffer |= (uint8_t)(clkOutFreq);
+
+    if (!pcf8523_write_register(pcf8523, PCF8523_TMR_CTRL_REG, buffer))
+        return false;
+
+    return true;
+}
+
+bool pcf8523_read_clk_out_mode(pcf8523_t *pcf8523, pcf8523_ClkSourceFreq_t *clkOutFreq) {
+    if (!pcf8523 || !clkOutFreq)
+        return false;
+
+    uint8_t buffer;
+
+    if (!pcf8523_read_register(pcf8523, PCF8523_TMR_CTRL_REG, &buffer))
+        return false;
+
+    buffer &= PCF8523_TMR_CTRL_CLKOUT_FREQ_MASK;
+
+    *clkOutFreq = (pcf8523_ClkSourceFreq_t)buffer;
+
+    return true;
+}
@@ -0,0 +1,250 @@
+#include "sensor/pcf8523_config.h"
+#include "pcf8523_private.h"
+#include "sensor/pcf8523.h"
+
+#define PCF8523_CONFIG_FIRST_REG PCF8523_CTRL1_REG
+#define PCF8523_CONFIG_LAST_REG PCF8523_TMR_B_FREQ_CTRL_REG
+#define PCF8523_CONFIG_LEN (PCF8523_CONFIG_LAST_REG - PCF8523_CONFIG_FIRST_REG + 1)
+
+#define PCF8523_CTRL3_BSF_MASK (1 << 3)
+#define PCF8523_OFFSET_VALUE_MASK 0x7F
+#define PCF8523_TMR_FREQ_MASK 0x07
+
+// Bits owned by the profile, everything else keeps its current value
+static const uint8_t pcf8523ConfigMask[PCF8523_CONFIG_LEN] = {
+    [PCF8523_CTRL1_REG] = PCF8523_CTRL1_CAP_SEL_MASK | PCF8523_CTRL1_HOUR_MODE_MASK | 0x07,
+    [PCF8523_CTRL2_REG] = 0x07,
+    [PCF8523_CTRL3_REG] = PCF8523_CTRL3_POWER_MODE_MASK | 0x03,
+    [PCF8523_OFFSET_REG] = 0xFF,
+    [PCF8523_TMR_CTRL_REG] = 0xFF,
+    [PCF8523_TMR_A_FREQ_CTRL_REG] = PCF8523_TMR_FREQ_MASK,
+    [PCF8523_TMR_B_FREQ_CTRL_REG] = PCF8523_TMR_B_INT_WIDTH_MASK | PCF8523_TMR_FREQ_MASK,
+};
+
+// Flags are cleared by writing 0, so they are written as 1 to leave them untouched
+static const uint8_t pcf8523ConfigKeep[PCF8523_CONFIG_LEN] = {
+    [PCF8523_CTRL2_REG] = PCF8523_CTRL2_FLAG_MASK,
+    [PCF8523_CTRL3_REG] = PCF8523_CTRL3_BSF_MASK,
+};
+
+// Registers that can be rewritten as part of a burst. The time, alarm and timer value registers
+// in between split the writes.
+static const struct {
+    uint8_t first;
+    uint8_t last;
+} pcf8523ConfigGroups[] = {
+    {PCF8523_CTRL1_REG, PCF8523_CTRL3_REG},
+    {PCF8523_OFFSET_REG, PCF8523_TMR_A_FREQ_CTRL_REG},
+    {PCF8523_TMR_B_FREQ_CTRL_REG, PCF8523_TMR_B_FREQ_CTRL_REG},
+};
+
+#define PCF8523_CONFIG_GROUP_COUNT (sizeof(pcf8523ConfigGroups) / sizeof(pcf8523ConfigGroups[0]))
+#define PCF8523_CONFIG_MAX_BURST 3
+
+static void pcf8523_config_encode(const pcf8523_Config_t *config, uint8_t *image) {
+    image[PCF8523_CTRL1_REG] = (uint8_t)(config->ctrl1Interrupts & 0x07);
+    if (config->capValue == PCF8523_12_5PF_CAPACITOR)
+        image[PCF8523_CTRL1_REG] |= PCF8523_CTRL1_CAP_SEL_MASK;
+    if (!config->format24h)
+        image[PCF8523_CTRL1_REG] |= PCF8523_CTRL1_HOUR_MODE_MASK;
+
+    image[PCF8523_CTRL2_REG] = (uint8_t)(config->ctrl2Interrupts & 0x07);
+    image[PCF8523_CTRL3_REG] =
+        (uint8_t)((config->ctrl3Interrupts & 0x03) | (uint8_t)config->powerMode);
+
+    image[PCF8523_OFFSET_REG] = (uint8_t)config->offset & PCF8523_OFFSET_VALUE_MASK;
+    if (config->offsetMode == PCF8523_OFFSET_EVERY_MIN)
+        image[PCF8523_OFFSET_REG] |= PCF8523_OFFSET_MODE_MASK;
+
+    image[PCF8523_TMR_CTRL_REG] = (uint8_t)((uint8_t)config->clkOutFreq |
+                                            (uint8_t)config->tmrAMode);
+    if (config->tmrAIntMode == PCF8523_TMR_PULSED_INT)
+        image[PCF8523_TMR_CTRL_REG] |= PCF8523_TMR_CTRL_PERM_TMR_A_TMR_SEC_INT_MASK;
+    if (config->tmrBIntMode == PCF8523_TMR_PULSED_INT)
+        image[PCF8523_TMR_CTRL_REG] |= PCF8523_TMR_CTRL_PERM_TMR_B_INT_MASK;
+    if (config->tmrBEnabled)
+        image[PCF8523_TMR_CTRL_REG] |= PCF8523_TMR_CTRL_TMR_B_ENABLED_MASK;
+
+    image[PCF8523_TMR_A_FREQ_CTRL_REG] = (uint8_t)config->tmrASourceFreq;
+    image[PCF8523_TMR_B_FREQ_CTRL_REG] =
+        (uint8_t)((uint8_t)config->tmrBIntWidth | (uint8_t)config->tmrBSourceFreq);
+}
+
+bool pcf8523_read_config(pcf8523_t *pcf8523, pcf8523_Config_t *config) {
+    if (!pcf8523 || !config)
+        return false;
+
+    uint8_t image[PCF8523_CONFIG_LEN];
+    if (!pcf8523_read_block(pcf8523, PCF8523_CONFIG_FIRST_REG, image, PCF8523_CONFIG_LEN))
+        return false;
+
+    uint8_t ctrl1 = image[PCF8523_CTRL1_REG];
+    config->capValue = (ctrl1 & PCF8523_CTRL1_CAP_SEL_MASK) ? PCF8523_12_5PF_CAPACITOR
+                                                             : PCF8523_7PF_CAPACITOR;
+    config->format24h = !(ctrl1 & PCF8523_CTRL1_HOUR_MODE_MASK);
+    config->ctrl1Interrupts = ctrl1 & 0x07;
+    config->ctrl2Interrupts = image[PCF8523_CTRL2_REG] & 0x07;
+    config->ctrl3Interrupts = image[PCF8523_CTRL3_REG] & 0x03;
+    config->powerMode =
+        (pcf8523_PowerModes_t)(image[PCF8523_CTRL3_REG] & PCF8523_CTRL3_POWER_MODE_MASK);
+
+    uint8_t offset = image[PCF8523_OFFSET_REG];
+    config->offsetMode = (offset & PCF8523_OFFSET_MODE_MASK) ? PCF8523_OFFSET_EVERY_MIN
+                                                             : PCF8523_OFFSET_EVERY_2_HOURS;
+    // 7 bit two's complement
+    offset &= PCF8523_OFFSET_VALUE_MASK;
+    if (offset & 0x40)
+        offset |= 0x80;
+    config->offset = (int8_t)offset;
+
+    uint8_t tmrCtrl = image[PCF8523_TMR_CTRL_REG];
+    config->clkOutFreq = (pcf8523_ClkOutFreq_t)(tmrCtrl & PCF8523_TMR_CTRL_CLKOUT_FREQ_MASK);
+    config->tmrAMode = (pcf8523_TmrAMode_t)(tmrCtrl & PCF8523_TMR_CTRL_TMR_A_MODE_MASK);
+    config->tmrAIntMode = (tmrCtrl & PCF8523_TMR_CTRL_PERM_TMR_A_TMR_SEC_INT_MASK)
+                              ? PCF8523_TMR_PULSED_INT
+                              : PCF8523_TMR_PERM_INT;
+    config->tmrBIntMode = (tmrCtrl & PCF8523_TMR_CTRL_PERM_TMR_B_INT_MASK) ? PCF8523_TMR_PULSED_INT
+                                                                           : PCF8523_TMR_PERM_INT;
+    config->tmrBEnabled = tmrCtrl & PCF8523_TMR_CTRL_TMR_B_ENABLED_MASK;
+
+    config->tmrASourceFreq =
+        (pcf8523_ClkSourceFreq_t)(image[PCF8523_TMR_A_FREQ_CTRL_REG] & PCF8523_TMR_FREQ_MASK);
+    config->tmrBSourceFreq =
+        (pcf8523_ClkSourceFreq_t)(image[PCF8523_TMR_B_FREQ_CTRL_REG] & PCF8523_TMR_FREQ_MASK);
+    config->tmrBIntWidth = (pcf8523_TmrBIntWidth_t)(image[PCF8523_TMR_B_FREQ_CTRL_REG] &
+                                                    PCF8523_TMR_B_INT_WIDTH_MASK);
+
+    return true;
+}
+
+bool pcf8523_apply_config(pcf8523_t *pcf8523, const pcf8523_Config_t *config, uint8_t *changed) {
+    if (!pcf8523 || !config)
+        return false;
+
+#if !PCF8523_SKIP_VALIDATION
+    if (config->offset > 63 || config->offset < -64)
+        return false;
+#endif
+
+#if PCF8523_FIXED_HOUR_FORMAT
+    if (config->format24h != (PCF8523_FIXED_HOUR_FORMAT == 24))
+        return false;
+#endif
+
+    uint8_t current[PCF8523_CONFIG_LEN];
+    if (!pcf8523_read_block(pcf8523, PCF8523_CONFIG_FIRST_REG, current, PCF8523_CONFIG_LEN))
+        return false;
+
+    uint8_t desired[PCF8523_CONFIG_LEN];
+    pcf8523_config_encode(config, desired);
+
+    uint8_t count = 0;
+    bool diff[PCF8523_CONFIG_LEN];
+    for (uint8_t reg = 0; reg < PCF8523_CONFIG_LEN; reg++) {
+        uint8_t mask = pcf8523ConfigMask[reg];
+
+        desired[reg] = (uint8_t)((current[reg] & ~mask) | (desired[reg] & mask));
+        diff[reg] = desired[reg] != current[reg];
+        if (diff[reg])
+            count++;
+
+        desired[reg] |= pcf8523ConfigKeep[reg];
+    }
+
+    // One burst per group, from its first to its last changed register
+    uint8_t frames[PCF8523_CONFIG_GROUP_COUNT][PCF8523_FRAME_SIZE(PCF8523_CONFIG_MAX_BURST)];
+    pcf8523_Transaction_t txs[PCF8523_CONFIG_GROUP_COUNT];
+    size_t txCount = 0;
+
+    for (size_t g = 0; g < PCF8523_CONFIG_GROUP_COUNT; g++) {
+        uint8_t first = pcf8523ConfigGroups[g].first;
+        uint8_t last = pcf8523ConfigGroups[g].last;
+
+        while (first <= last && !diff[first])
+            first++;
+        while (last > first && !diff[last])
+            last--;
+        if (first > last)
+            continue;
+
+        size_t len = (size_t)(last - first + 1);
+        if (!pcf8523_transaction_init(&txs[txCount], first, frames[txCount], len, true))
+            return false;
+
+        uint8_t *data = pcf8523_transaction_data(&txs[txCount]);
+        for (size_t i = 0; i < len; i++)
+            data[i] = desired[first + i];
+
+        txCount++;
+    }
+
+    if (txCount && !pcf8523_execute_list(pcf8523, txs, txCount))
+        return false;
+
+    pcf8523->format24h = config->format24h;
+
+    if (changed)
+        *changed = count;
+
+    return true;
+}
+
+bool pcf8523_save_state(pcf8523_t *pcf8523, pcf8523_State_t *state) {
+    if (!pcf8523 || !state)
+        return false;
+
+    return pcf8523_read_block(pcf8523, PCF8523_CTRL1_REG, state->regs, PCF8523_REGISTER_COUNT);
+}
+
+bool pcf8523_restore_state(pcf8523_t *pcf8523, const pcf8523_State_t *state, bool preserveTime) {
+    if (!pcf8523 || !state)
+        return false;
+
+#if PCF8523_FIXED_HOUR_FORMAT
+    bool format24h = !(state->regs[PCF8523_CTRL1_REG] & PCF8523_CTRL1_HOUR_MODE_MASK);
+    if (format24h != (PCF8523_FIXED_HOUR_FORMAT == 24))
+        return false;
+#endif
+
+    uint8_t frame[PCF8523_FRAME_SIZE(PCF8523_REGISTER_COUNT)];
+    uint8_t *data = &frame[1];
+
+    for (uint8_t reg = 0; reg < PCF8523_REGISTER_COUNT; reg++)
+        data[reg] = state->regs[reg];
+
+    // The reset bit is never written back, the flags are written as 1 to keep them
+    data[PCF8523_CTRL1_REG] &= (uint8_t)(~PCF8523_CTRL1_RESET_MASK);
+    data[PCF8523_CTRL2_REG] |= PCF8523_CTRL2_FLAG_MASK;
+    data[PCF8523_CTRL3_REG] |= PCF8523_CTRL3_BSF_MASK;
+
+    pcf8523_Transaction_t txs[2];
+    size_t txCount = 1;
+
+    // The alarm and timer registers follow the time ones, so they get a frame of their own
+    uint8_t tail[PCF8523_FRAME_SIZE(PCF8523_REGISTER_COUNT - PCF8523_MINUTES_ALARM_REG)];
+    size_t tailLen = PCF8523_REGISTER_COUNT - PCF8523_MINUTES_ALARM_REG;
+
+    if (preserveTime) {
+        if (!pcf8523_transaction_init(&txs[0], PCF8523_CTRL1_REG, frame,
+                                      PCF8523_SECONDS_REG - PCF8523_CTRL1_REG, true))
+            return false;
+        if (!pcf8523_transaction_init(&txs[1], PCF8523_MINUTES_ALARM_REG, tail, tailLen, true))
+            return false;
+
+        for (size_t i = 0; i < tailLen; i++)
+            tail[1 + i] = data[PCF8523_MINUTES_ALARM_REG + i];
+
+        txCount = 2;
+    }
+    else if (!pcf8523_transaction_init(&txs[0], PCF8523_CTRL1_REG, frame, PCF8523_REGISTER_COUNT,
+                                         true)) {
+        return false;
+    }
+
+    if (!pcf8523_execute_list(pcf8523, txs, txCount))
+        return false;
+
+    pcf8523->format24h = !(state->regs[PCF8523_CTRL1_REG] & PCF8523_CTRL1_HOUR_MODE_MASK);
+
+    return true;
+}
@@ -0,0 +1,247 @@
+#include "sensor/pcf8523_datetime.h"
+#include "pcf8523_private.h"
+#include "sensor/pcf8523.h"
+
+#define PCF8523_DATETIME_CYCLE_DAYS 1461 // 4 years, always holding one February 29
+
+static const uint8_t pcf8523DatetimeMonthDays[12] = {31, 28, 31, 30, 31, 30,
+                                                     31, 31, 30, 31, 30, 31};
+
+static const uint16_t pcf8523DatetimeMonthAccum[12] = {0,   31,  59,  90,  120, 151,
+                                                       181, 212, 243, 273, 304, 334};
+
+static inline uint8_t pcf8523_datetime_month_days(uint8_t year, uint8_t month) {
+    if (month == 2 && (year & 3) == 0)
+        return 29;
+
+    return pcf8523DatetimeMonthDays[month - 1];
+}
+
+static inline uint8_t pcf8523_datetime_hour24(const pcf8523_Datetime_t *datetime) {
+    if (datetime->hourMode == PCF8523_HOUR_MODE_24H)
+        return datetime->hour;
+
+    uint8_t hour = datetime->hour == 12 ? 0 : datetime->hour;
+
+    return datetime->hourMode == PCF8523_HOUR_MODE_PM ? (uint8_t)(hour + 12) : hour;
+}
+
+static inline void pcf8523_datetime_set_hour24(pcf8523_Datetime_t *datetime, uint8_t hour) {
+    if (datetime->hourMode == PCF8523_HOUR_MODE_24H) {
+        datetime->hour = hour;
+        return;
+    }
+
+    datetime->hourMode = hour >= 12 ? PCF8523_HOUR_MODE_PM : PCF8523_HOUR_MODE_AM;
+    hour %= 12;
+    datetime->hour = hour == 0 ? 12 : hour;
+}
+
+// Days since 01-01-00
+static inline int32_t pcf8523_datetime_day_number(const pcf8523_Datetime_t *datetime) {
+    int32_t year = datetime->year;
+    int32_t days = year * 365 + (year + 3) / 4 + pcf8523DatetimeMonthAccum[datetime->month - 1] +
+                   datetime->day - 1;
+
+    if (datetime->month > 2 && (year & 3) == 0)
+        days++;
+
+    return days;
+}
+
+static inline int32_t pcf8523_datetime_second_of_day(const pcf8523_Datetime_t *datetime) {
+    return (int32_t)pcf8523_datetime_hour24(datetime) * 3600 + datetime->min * 60 + datetime->sec;
+}
+
+// Brings value into [0, base) and returns what was carried out of it
+static inline int32_t pcf8523_datetime_carry(int32_t *value, int32_t base) {
+    int32_t carry = *value / base;
+
+    *value %= base;
+    if (*value < 0) {
+        *value += base;
+        carry--;
+    }
+
+    return carry;
+}
+
+// Checked here even with PCF8523_SKIP_VALIDATION, the month indexes the tables
+static inline bool pcf8523_datetime_valid(const pcf8523_Datetime_t *datetime) {
+    if (!pcf8523_validate_year(datetime->year) || !pcf8523_validate_month(datetime->month))
+        return false;
+
+    if (datetime->day < 1 || datetime->day > pcf8523_datetime_month_days(datetime->year,
+                                                                          datetime->month))
+        return false;
+
+    return pcf8523_validate_sec(datetime->sec) && pcf8523_validate_min(datetime->min) &&
+           pcf8523_validate_hour(datetime->hour, datetime->hourMode,
+                                 datetime->hourMode == PCF8523_HOUR_MODE_24H) &&
+           pcf8523_validate_weekday(datetime->weekDay);
+}
+
+static bool pcf8523_datetime_carry_days(pcf8523_Datetime_t *datetime, int32_t days) {
+    if (days == 0)
+        return true;
+
+    int32_t year = datetime->year;
+    int32_t month = datetime->month;
+    int32_t day = datetime->day;
+
+    int32_t weekDay = datetime->weekDay + days % 7;
+    pcf8523_datetime_carry(&weekDay, 7);
+
+    int32_t cycles = days / PCF8523_DATETIME_CYCLE_DAYS;
+    year += cycles * 4;
+    day += days - cycles * PCF8523_DATETIME_CYCLE_DAYS;
+
+    for (;;) {
+        if (year < 0 || year > 99)
+            return false;
+
+        uint8_t monthDays = pcf8523_datetime_month_days((uint8_t)year, (uint8_t)month);
+
+        if (day > monthDays) {
+            day -= monthDays;
+            if (++month > 12) {
+                month = 1;
+                year++;
+            }
+        }
+        else if (day < 1) {
+            if (--month < 1) {
+                month = 12;
+                year--;
+            }
+            if (year < 0)
+                return false;
+            day += pcf8523_datetime_month_days((uint8_t)year, (uint8_t)month);
+        }
+        else {
+            break;
+        }
+    }
+
+    datetime->year = (uint8_t)year;
+    datetime->month = (uint8_t)month;
+    datetime->day = (uint8_t)day;
+    datetime->weekDay = (uint8_t)weekDay;
+
+    return true;
+}
+
+bool pcf8523_datetime_add_seconds(pcf8523_Datetime_t *datetime, int32_t seconds) {
+    if (!datetime || !pcf8523_datetime_valid(datetime))
+        return false;
+
+    int32_t sec = datetime->sec + seconds % 60;
+    int32_t minutes = seconds / 60 + pcf8523_datetime_carry(&sec, 60);
+
+    int32_t min = datetime->min + minutes % 60;
+    int32_t hours = minutes / 60 + pcf8523_datetime_carry(&min, 60);
+
+    int32_t hour = pcf8523_datetime_hour24(datetime) + hours % 24;
+    int32_t days = hours / 24 + pcf8523_datetime_carry(&hour, 24);
+
+    pcf8523_Datetime_t result = *datetime;
+    if (!pcf8523_datetime_carry_days(&result, days))
+        return false;
+
+    result.sec = (uint8_t)sec;
+    result.min = (uint8_t)min;
+    pcf8523_datetime_set_hour24(&result, (uint8_t)hour);
+
+    *datetime = result;
+
+    return true;
+}
+
+bool pcf8523_datetime_add_minutes(pcf8523_Datetime_t *datetime, int32_t minutes) {
+    if (!datetime || !pcf8523_datetime_valid(datetime))
+        return false;
+
+    int32_t min = datetime->min + minutes % 60;
+    int32_t hours = minutes / 60 + pcf8523_datetime_carry(&min, 60);
+
+    int32_t hour = pcf8523_datetime_hour24(datetime) + hours % 24;
+    int32_t days = hours / 24 + pcf8523_datetime_carry(&hour, 24);
+
+    pcf8523_Datetime_t result = *datetime;
+    if (!pcf8523_datetime_carry_days(&result, days))
+        return false;
+
+    result.min = (uint8_t)min;
+    pcf8523_datetime_set_hour24(&result, (uint8_t)hour);
+
+    *datetime = result;
+
+    return true;
+}
+
+bool pcf8523_datetime_add_days(pcf8523_Datetime_t *datetime, int32_t days) {
+    if (!datetime || !pcf8523_datetime_valid(datetime))
+        return false;
+
+    pcf8523_Datetime_t result = *datetime;
+    if (!pcf8523_datetime_carry_days(&result, days))
+        return false;
+
+    *datetime = result;
+
+    return true;
+}
+
+bool pcf8523_datetime_add_months(pcf8523_Datetime_t *datetime, int32_t months) {
+    if (!datetime || !pcf8523_datetime_valid(datetime))
+        return false;
+
+    if (months < -1200 || months > 1200)
+        return false;
+
+    int32_t total = datetime->year * 12 + datetime->month - 1 + months;
+    if (total < 0 || total >= 100 * 12)
+        return false;
+
+    pcf8523_Datetime_t result = *datetime;
+    result.year = (uint8_t)(total / 12);
+    result.month = (uint8_t)(total % 12 + 1);
+
+    uint8_t monthDays = pcf8523_datetime_month_days(result.year, result.month);
+    if (result.day > monthDays)
+        result.day = monthDays;
+
+    int32_t days = pcf8523_datetime_day_number(&result) - pcf8523_datetime_day_number(datetime);
+    int32_t weekDay = result.weekDay + days % 7;
+    pcf8523_datetime_carry(&weekDay, 7);
+    result.weekDay = (uint8_t)weekDay;
+
+    *datetime = result;
+
+    return true;
+}
+
+int pcf8523_datetime_compare(const pcf8523_Datetime_t *a, const pcf8523_Datetime_t *b) {
+    if (!a || !b || !pcf8523_datetime_valid(a) || !pcf8523_datetime_valid(b))
+        return 0;
+
+    // year:7 month:4 day:5 hour:5 min:6 sec:6, ordered like the fields
+    uint64_t keyA = ((uint64_t)a->year << 26) | ((uint32_t)a->month << 22) |
+                    ((uint32_t)a->day << 17) | ((uint32_t)pcf8523_datetime_hour24(a) << 12) |
+                    ((uint32_t)a->min << 6) | a->sec;
+    uint64_t keyB = ((uint64_t)b->year << 26) | ((uint32_t)b->month << 22) |
+                    ((uint32_t)b->day << 17) | ((uint32_t)pcf8523_datetime_hour24(b) << 12) |
+                    ((uint32_t)b->min << 6) | b->sec;
+
+    return (keyA > keyB) - (keyA < keyB);
+}
+
+int64_t pcf8523_datetime_diff_seconds(const pcf8523_Datetime_t *a, const pcf8523_Datetime_t *b) {
+    if (!a || !b || !pcf8523_datetime_valid(a) || !pcf8523_datetime_valid(b))
+        return 0;
+
+    int32_t days = pcf8523_datetime_day_number(a) - pcf8523_datetime_day_number(b);
+    int32_t seconds = pcf8523_datetime_second_of_day(a) - pcf8523_datetime_second_of_day(b);
+
+    return (int64_t)days * 86400 + seconds;
+}
@@ -0,0 +1,254 @@
+#include "sensor/pcf8523_dual.h"
+#include "hardware/i2c.h"
+#include "pcf8523_private.h"
+#include "pico/stdlib.h"
+#include "sensor/pcf8523.h"
+
+#define PCF8523_DUAL_READ_LEN 10 // CTRL1..YEARS, fits the 16 entry FIFOs with the command
+
+typedef struct {
+    i2c_hw_t *hw;
+    bool pending;
+    bool ok;
+    uint8_t regs[PCF8523_DUAL_READ_LEN];
+} pcf8523_DualTransfer_t;
+
+// Queues the register pointer write and the reads, the controller runs them on its own
+static void pcf8523_dual_start(pcf8523_DualTransfer_t *transfer, const pcf8523_t *pcf8523) {
+    i2c_hw_t *hw = i2c_get_hw(pcf8523->i2c);
+
+    transfer->hw = hw;
+    transfer->pending = true;
+    transfer->ok = false;
+
+    hw->enable = 0;
+    hw->tar = pcf8523->i2cAddress;
+    hw->enable = 1;
+
+    while (hw->rxflr)
+        (void)hw->data_cmd;
+    (void)hw->clr_tx_abrt;
+
+    hw->data_cmd = PCF8523_CTRL1_REG;
+    for (uint8_t i = 0; i < PCF8523_DUAL_READ_LEN; i++) {
+        uint32_t cmd = I2C_IC_DATA_CMD_CMD_BITS;
+        if (i == 0)
+            cmd |= I2C_IC_DATA_CMD_RESTART_BITS;
+        if (i == PCF8523_DUAL_READ_LEN - 1)
+            cmd |= I2C_IC_DATA_CMD_STOP_BITS;
+        hw->data_cmd = cmd;
+    }
+}
+
+static void pcf8523_dual_poll(pcf8523_DualTransfer_t *transfer) {
+    i2c_hw_t *hw = transfer->hw;
+
+    if (hw->raw_intr_stat & I2C_IC_RAW_INTR_STAT_TX_ABRT_BITS) {
+        (void)hw->clr_tx_abrt;
+        transfer->pending = false;
+        return;
+    }
+
+    if (hw->rxflr < PCF8523_DUAL_READ_LEN)
+        return;
+
+    for (uint8_t i = 0; i < PCF8523_DUAL_READ_LEN; i++)
+        transfer->regs[i] = (uint8_t)hw->data_cmd;
+
+    transfer->pending = false;
+    transfer->ok = true;
+}
+
+static uint8_t pcf8523_dual_rate(const pcf8523_Dual_t *dual, uint8_t index,
+                                 const pcf8523_DualTransfer_t *transfer,
+                                 pcf8523_Datetime_t *datetime) {
+    if (!transfer->ok)
+        return PCF8523_DUAL_HEALTH_BUS;
+
+    const uint8_t *regs = transfer->regs;
+    uint8_t health = 0;
+
+    if (regs[PCF8523_SECONDS_REG] & PCF8523_SECONDS_OS_MASK)
+        health |= PCF8523_DUAL_HEALTH_OS;
+    if (regs[PCF8523_CTRL1_REG] & PCF8523_CTRL1_STOP_MASK)
+        health |= PCF8523_DUAL_HEALTH_STOP;
+    if (regs[PCF8523_CTRL3_REG] & PCF8523_CTRL3_BATT_STATUS_INT_FLAG_MASK_RO)
+        health |= PCF8523_DUAL_HEALTH_BLF;
+    if (regs[PCF8523_CTRL3_REG] & PCF8523_CTRL3_BATT_SWITCH_OVER_INT_FLAG_MASK)
+        health |= PCF8523_DUAL_HEALTH_BSF;
+
+    bool format24h = PCF8523_FORMAT_24H(dual->rtc[index]);
+    pcf8523_decode_datetime(&regs[PCF8523_SECONDS_REG], format24h, datetime);
+
+    // Garbage in the time registers must not reach the selection
+    if (!pcf8523_validate_sec(datetime->sec) || !pcf8523_validate_min(datetime->min) ||
+        !pcf8523_validate_hour(datetime->hour, datetime->hourMode, format24h) ||
+        !pcf8523_validate_day(datetime->day) || !pcf8523_validate_weekday(datetime->weekDay) ||
+        !pcf8523_validate_month(datetime->month) || !pcf8523_validate_year(datetime->year))
+        health |= PCF8523_DUAL_HEALTH_INVALID;
+
+    return health;
+}
+
+// The reads drive the controllers directly, which only the plain SDK transport tolerates
+static bool pcf8523_dual_direct(const pcf8523_t *pcf8523) {
+    return pcf8523->i2c && pcf8523->transport == &pcf8523_pico_transport &&
+           pcf8523->transportCtx == pcf8523->i2c;
+}
+
+bool pcf8523_dual_init(pcf8523_Dual_t *dual, pcf8523_t *rtc0, pcf8523_t *rtc1, uint16_t century) {
+    if (!dual || !rtc0 || !rtc1 || !pcf8523_dual_direct(rtc0) || !pcf8523_dual_direct(rtc1))
+        return false;
+
+    if (rtc0->i2c == rtc1->i2c)
+        return false;
+
+    dual->rtc[0] = rtc0;
+    dual->rtc[1] = rtc1;
+    dual->century = century;
+    dual->toleranceS = PCF8523_DUAL_TOLERANCE_S;
+    dual->timeoutUs = PCF8523_DUAL_TIMEOUT_US;
+    dual->health[0] = PCF8523_DUAL_HEALTH_BUS;
+    dual->health[1] = PCF8523_DUAL_HEALTH_BUS;
+    dual->selected = PCF8523_DUAL_NONE;
+    dual->predicted = false;
+    pcf8523_dual_reset_stats(dual);
+
+    return true;
+}
+
+static void pcf8523_dual_record_divergence(pcf8523_DualStats_t *stats, int32_t divergence) {
+    if (stats->compared == 0 || divergence < stats->minDivergence)
+        stats->minDivergence = divergence;
+    if (stats->compared == 0 || divergence > stats->maxDivergence)
+        stats->maxDivergence = divergence;
+
+    stats->compared++;
+    stats->lastDivergence = divergence;
+    stats->sumDivergence += divergence;
+}
+
+static uint8_t pcf8523_dual_select(pcf8523_Dual_t *dual, const uint64_t *epoch, uint64_t startUs) {
+    const uint8_t degradedMask = PCF8523_DUAL_HEALTH_BLF | PCF8523_DUAL_HEALTH_BSF;
+    bool usable0 = !(dual->health[0] & PCF8523_DUAL_HEALTH_UNUSABLE);
+    bool usable1 = !(dual->health[1] & PCF8523_DUAL_HEALTH_UNUSABLE);
+
+    if (!usable0 || !usable1)
+        return usable0 ? 0 : (usable1 ? 1 : PCF8523_DUAL_NONE);
+
+    int32_t divergence = (int32_t)((int64_t)epoch[1] - (int64_t)epoch[0]);
+    pcf8523_dual_record_divergence(&dual->stats, divergence);
+
+    bool disagree = (uint32_t)(divergence < 0 ? -divergence : divergence) > dual->toleranceS;
+    if (disagree)
+        dual->stats.disagreements++;
+
+    bool degraded0 = dual->health[0] & degradedMask;
+    bool degraded1 = dual->health[1] & degradedMask;
+    if (degraded0 != degraded1)
+        return degraded0 ? 1 : 0;
+
+    if (disagree && dual->predicted) {
+        uint64_t prediction = dual->lastEpoch + (startUs - dual->lastUs) / 1000000ULL;
+        int64_t error0 = (int64_t)(epoch[0] - prediction);
+        int64_t error1 = (int64_t)(epoch[1] - prediction);
+
+        if (error0 < 0)
+            error0 = -error0;
+        if (error1 < 0)
+            error1 = -error1;
+
+        if (error0 != error1)
+            return error0 < error1 ? 0 : 1;
+    }
+
+    // Sticking to the same device avoids jumping between the two when they agree
+    return dual->selected == PCF8523_DUAL_NONE ? 0 : dual->selected;
+}
+
+bool pcf8523_dual_read(pcf8523_Dual_t *dual, pcf8523_Datetime_t *datetime, uint8_t *source) {
+    if (!dual || !datetime)
+        return false;
+
+    pcf8523_DualTransfer_t transfers[2];
+    pcf8523_Datetime_t datetimes[2];
+    uint64_t epoch[2] = {0, 0};
+
+    uint64_t startUs = time_us_64();
+    pcf8523_dual_start(&transfers[0], dual->rtc[0]);
+    pcf8523_dual_start(&transfers[1], dual->rtc[1]);
+
+    while (transfers[0].pending || transfers[1].pending) {
+        for (uint8_t i = 0; i < 2; i++) {
+            if (transfers[i].pending)
+                pcf8523_dual_poll(&transfers[i]);
+        }
+
+        if (time_us_64() - startUs > dual->timeoutUs)
+            break;
+    }
+
+    // A stuck transfer is aborted so that it does not complete into the next read
+    for (uint8_t i = 0; i < 2; i++) {
+        if (transfers[i].pending)
+            transfers[i].hw->enable |= I2C_IC_ENABLE_ABORT_BITS;
+    }
+
+    uint32_t readUs = (uint32_t)(time_us_64() - startUs);
+    dual->stats.lastReadUs = readUs;
+    if (readUs > dual->stats.maxReadUs)
+        dual->stats.maxReadUs = readUs;
+    dual->stats.reads++;
+
+    for (uint8_t i = 0; i < 2; i++) {
+        dual->health[i] = pcf8523_dual_rate(dual, i, &transfers[i], &datetimes[i]);
+        if (dual->health[i] & PCF8523_DUAL_HEALTH_UNUSABLE)
+            dual->stats.unusable[i]++;
+        else
+            epoch[i] = pcf8523_datetime_to_epoch(&datetimes[i], dual->century);
+    }
+
+    uint8_t selected = pcf8523_dual_select(dual, epoch, startUs);
+    if (selected == PCF8523_DUAL_NONE) {
+        dual->stats.failedReads++;
+        return false;
+    }
+
+    if (dual->selected != PCF8523_DUAL_NONE && selected != dual->selected)
+        dual->stats.switches++;
+    dual->stats.selected[selected]++;
+
+    dual->selected = selected;
+    dual->predicted = true;
+    dual->lastEpoch = epoch[selected];
+    dual->lastUs = startUs;
+
+    *datetime = datetimes[selected];
+    if (source)
+        *source = selected;
+
+    return true;
+}
+
+uint8_t pcf8523_dual_health(const pcf8523_Dual_t *dual, uint8_t index) {
+    if (!dual || index > 1)
+        return PCF8523_DUAL_HEALTH_BUS;
+
+    return dual->health[index];
+}
+
+bool pcf8523_dual_read_stats(const pcf8523_Dual_t *dual, pcf8523_DualStats_t *stats) {
+    if (!dual || !stats)
+        return false;
+
+    *stats = dual->stats;
+
+    return true;
+}
+
+void pcf8523_dual_reset_stats(pcf8523_Dual_t *dual) {
+    if (!dual)
+        return;
+
+    dual->stats = (pcf8523_DualStats_t){0};
+}
@@ -0,0 +1,148 @@
+#include "sensor/pcf8523_edge.h"
+#include "hardware/gpio.h"
+#include "pcf8523_private.h"
+#include "pico/stdlib.h"
+#include "sensor/pcf8523.h"
+
+bool pcf8523_second_edge_init(pcf8523_SecondEdge_t *edge, pcf8523_t *pcf8523, int intPin) {
+    if (!edge || !pcf8523)
+        return false;
+
+    edge->pcf8523 = pcf8523;
+    edge->intPin = intPin;
+    edge->locked = false;
+    edge->lastEdgeUs = 0;
+    edge->lastUncertaintyUs = 0;
+    edge->reads = 0;
+
+    if (intPin == PCF8523_EDGE_NO_PIN)
+        return true;
+
+    if (intPin < 0)
+        return false;
+
+    // INT1 is open drain
+    gpio_init((uint)intPin);
+    gpio_set_dir((uint)intPin, GPIO_IN);
+    gpio_pull_up((uint)intPin);
+
+    if (!pcf8523_set_timer_int_mode(pcf8523, PCF8523_TMR_A_TMR_SEC, PCF8523_TMR_PULSED_INT))
+        return false;
+
+    return pcf8523_enable_interrupt_source(pcf8523, PCF8523_CTRL1_REG,
+                                           PCF8523_CTRL1_ENABLE_SECOND_INT_MASK, true);
+}
+
+// Sleeps until shortly before the next predicted edge and returns the end of its window
+static uint64_t pcf8523_edge_sleep(pcf8523_SecondEdge_t *edge, uint64_t deadline) {
+    if (!edge->locked)
+        return 0;
+
+    uint64_t now = time_us_64();
+    if (now < edge->lastEdgeUs)
+        return 0;
+
+    uint64_t seconds = (now - edge->lastEdgeUs) / 1000000ULL + 1;
+    uint64_t elapsed = seconds * 1000000ULL;
+    uint64_t guard = PCF8523_EDGE_GUARD_US + edge->lastUncertaintyUs +
+                     (elapsed * PCF8523_EDGE_DRIFT_PPM) / 1000000ULL;
+
+    uint64_t wakeUs = edge->lastEdgeUs + elapsed - guard;
+    if (wakeUs > deadline)
+        wakeUs = deadline;
+
+    if (wakeUs > now)
+        sleep_us(wakeUs - now);
+
+    return edge->lastEdgeUs + elapsed + guard;
+}
+
+static bool pcf8523_edge_wait_pin(pcf8523_SecondEdge_t *edge, uint64_t deadline,
+                                  uint64_t *edgeUs, uint32_t *uncertaintyUs) {
+    uint pin = (uint)edge->intPin;
+
+    // A pulse may still be in progress
+    while (!gpio_get(pin)) {
+        if (time_us_64() >= deadline)
+            return false;
+    }
+
+    uint64_t prev = time_us_64();
+    while (prev < deadline) {
+        bool high = gpio_get(pin);
+        uint64_t now = time_us_64();
+
+        if (!high) {
+            *edgeUs = prev + (now - prev) / 2;
+            *uncertaintyUs = (uint32_t)((now - prev + 1) / 2);
+            return true;
+        }
+
+        prev = now;
+    }
+
+    return false;
+}
+
+static bool pcf8523_edge_wait_poll(pcf8523_SecondEdge_t *edge, uint64_t deadline,
+                                   uint64_t windowEnd, uint64_t *edgeUs,
+                                   uint32_t *uncertaintyUs) {
+    uint8_t first;
+    uint8_t seconds;
+
+    // The time registers are latched at the start of the read access
+    uint64_t prev = time_us_64();
+    if (!pcf8523_read_register(edge->pcf8523, PCF8523_SECONDS_REG, &first))
+        return false;
+    edge->reads++;
+
+    while (prev < deadline) {
+        // Outside the predicted window the change is only bracketed by the coarse interval
+        if (prev >= windowEnd)
+            sleep_us(PCF8523_EDGE_COARSE_POLL_US);
+
+        uint64_t now = time_us_64();
+        if (!pcf8523_read_register(edge->pcf8523, PCF8523_SECONDS_REG, &seconds))
+            return false;
+        edge->reads++;
+
+        if (seconds != first) {
+            *edgeUs = prev + (now - prev) / 2;
+            *uncertaintyUs = (uint32_t)((now - prev + 1) / 2);
+            return true;
+        }
+
+        prev = now;
+    }
+
+    return false;
+}
+
+bool pcf8523_wait_second_edge(pcf8523_SecondEdge_t *edge, uint64_t timeoutUs, uint64_t *edgeUs,
+                              uint32_t *uncertaintyUs) {
+    if (!edge || !edge->pcf8523 || !edgeUs)
+        return false;
+
+    uint64_t deadline = time_us_64() + timeoutUs;
+    uint32_t uncertainty;
+
+    uint64_t windowEnd = pcf8523_edge_sleep(edge, deadline);
+
+    bool found;
+    if (edge->intPin != PCF8523_EDGE_NO_PIN)
+        found = pcf8523_edge_wait_pin(edge, deadline, edgeUs, &uncertainty);
+    else
+        found = pcf8523_edge_wait_poll(edge, deadline, windowEnd, edgeUs, &uncertainty);
+
+    if (!found)
+        return false;
+
+    edge->locked = true;
+    edge->lastEdgeUs = *edgeUs;
+    edge->lastUncertaintyUs = uncertainty;
+
+    if (uncertaintyUs)
+        *uncertaintyUs = uncertainty;
+
+    return true;
+}
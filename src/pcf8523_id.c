@@ -0,0 +1,249 @@
+#include "sensor/pcf8523_id.h"
+#include "sensor/pcf8523.h"
+
+#define PCF8523_ID128_COUNTER_MAX ((1UL << PCF8523_ID128_COUNTER_BITS) - 1)
+#define PCF8523_ID64_COUNTER_MAX ((1UL << PCF8523_ID64_COUNTER_BITS) - 1)
+#define PCF8523_ID64_NODE_MASK ((1UL << PCF8523_ID64_NODE_BITS) - 1)
+
+static const char pcf8523IdHex[16] = "0123456789abcdef";
+static const char pcf8523IdCrockford[32] = "0123456789ABCDEFGHJKMNPQRSTVWXYZ";
+
+// The ms of a us timestamp, the 64 bit division is only done when a new ms starts
+typedef struct {
+    uint64_t ms;
+    uint32_t sub; // us into the ms
+} pcf8523_IdSplit_t;
+
+static inline pcf8523_IdSplit_t pcf8523_id_split(pcf8523_IdGen_t *gen, uint64_t us) {
+    pcf8523_IdSplit_t split;
+
+    if (us < gen->msStartUs || us - gen->msStartUs >= 1000) {
+        gen->ms = us / 1000;
+        gen->msStartUs = gen->ms * 1000;
+    }
+
+    split.ms = gen->ms;
+    split.sub = (uint32_t)(us - gen->msStartUs);
+
+    return split;
+}
+
+static inline uint64_t pcf8523_id_now_us(const pcf8523_IdGen_t *gen) {
+    return gen->anchorEpochUs + (gen->clock() - gen->anchorClockUs);
+}
+
+// Returns the timestamp to use, never below the previous one, and sets the counter
+static inline uint64_t pcf8523_id_advance(pcf8523_IdGen_t *gen, pcf8523_IdSequence_t *seq,
+                                          uint64_t now, uint32_t counterMax) {
+    if (now > seq->last) {
+        seq->last = now;
+        seq->counter = 0;
+        return now;
+    }
+
+    // Same tick, or the time went back: count on from the last timestamp
+    if (seq->counter < counterMax) {
+        seq->counter++;
+    }
+    else {
+        seq->last++;
+        seq->counter = 0;
+    }
+
+    gen->carried += seq->last > now;
+
+    return seq->last;
+}
+
+static bool pcf8523_id_read_rtc(pcf8523_IdGen_t *gen, uint64_t *epoch, uint64_t *clockUs) {
+    pcf8523_Datetime_t datetime;
+
+    uint64_t before = gen->clock();
+    if (!pcf8523_read_datetime(gen->pcf8523, &datetime))
+        return false;
+    uint64_t after = gen->clock();
+
+    *epoch = pcf8523_datetime_to_epoch(&datetime, gen->century);
+    *clockUs = before + (after - before) / 2;
+
+    return true;
+}
+
+bool pcf8523_id_init(pcf8523_IdGen_t *gen, pcf8523_t *pcf8523, uint16_t century,
+                     pcf8523_IdClock_t clock, uint32_t node) {
+    if (!gen || !pcf8523 || !clock)
+        return false;
+
+    gen->pcf8523 = pcf8523;
+    gen->century = century;
+    gen->clock = clock;
+    gen->node = node;
+    gen->seq128 = (pcf8523_IdSequence_t){0};
+    gen->seq64 = (pcf8523_IdSequence_t){0};
+    gen->resyncs = 0;
+    gen->adjustments = 0;
+    gen->carried = 0;
+    gen->msStartUs = UINT64_MAX;
+    gen->ms = 0;
+
+    uint64_t epoch;
+    uint64_t clockUs;
+    if (!pcf8523_id_read_rtc(gen, &epoch, &clockUs))
+        return false;
+
+    // The phase inside the second is unknown, the middle bounds the error to half a second
+    gen->anchorEpochUs = epoch * 1000000ULL + 500000ULL;
+    gen->anchorClockUs = clockUs;
+
+    return true;
+}
+
+bool pcf8523_id_resync(pcf8523_IdGen_t *gen) {
+    if (!gen || !gen->pcf8523)
+        return false;
+
+    uint64_t epoch;
+    uint64_t clockUs;
+    if (!pcf8523_id_read_rtc(gen, &epoch, &clockUs))
+        return false;
+
+    uint64_t predicted = gen->anchorEpochUs + (clockUs - gen->anchorClockUs);
+    uint64_t lo = epoch * 1000000ULL;
+    uint64_t hi = lo + 999999ULL;
+
+    // Only as far as needed to get back inside the second the RTC showed
+    if (predicted < lo) {
+        predicted = lo;
+        gen->adjustments++;
+    }
+    else if (predicted > hi) {
+        predicted = hi;
+        gen->adjustments++;
+    }
+
+    gen->anchorEpochUs = predicted;
+    gen->anchorClockUs = clockUs;
+    gen->resyncs++;
+
+    return true;
+}
+
+void pcf8523_id_anchor(pcf8523_IdGen_t *gen, uint64_t epoch, uint64_t clockUs) {
+    if (!gen)
+        return;
+
+    gen->anchorEpochUs = epoch * 1000000ULL;
+    gen->anchorClockUs = clockUs;
+}
+
+static inline void pcf8523_id_pack128(pcf8523_IdGen_t *gen, uint64_t us, uint32_t counter,
+                                      pcf8523_Id128_t *id) {
+    pcf8523_IdSplit_t split = pcf8523_id_split(gen, us);
+    uint32_t fraction = (split.sub * 4096) / 1000; // Distinct for every us of the ms
+    uint8_t *b = id->bytes;
+
+    b[0] = (uint8_t)(split.ms >> 40);
+    b[1] = (uint8_t)(split.ms >> 32);
+    b[2] = (uint8_t)(split.ms >> 24);
+    b[3] = (uint8_t)(split.ms >> 16);
+    b[4] = (uint8_t)(split.ms >> 8);
+    b[5] = (uint8_t)split.ms;
+    b[6] = (uint8_t)(0x70 | (fraction >> 8)); // Version 7
+    b[7] = (uint8_t)fraction;
+    b[8] = (uint8_t)(0x80 | (counter >> 24)); // Variant 0b10
+    b[9] = (uint8_t)(counter >> 16);
+    b[10] = (uint8_t)(counter >> 8);
+    b[11] = (uint8_t)counter;
+    b[12] = (uint8_t)(gen->node >> 24);
+    b[13] = (uint8_t)(gen->node >> 16);
+    b[14] = (uint8_t)(gen->node >> 8);
+    b[15] = (uint8_t)gen->node;
+}
+
+void pcf8523_id_next128(pcf8523_IdGen_t *gen, pcf8523_Id128_t *id) {
+    if (!gen || !id)
+        return;
+
+    uint64_t us =
+        pcf8523_id_advance(gen, &gen->seq128, pcf8523_id_now_us(gen), PCF8523_ID128_COUNTER_MAX);
+
+    pcf8523_id_pack128(gen, us, gen->seq128.counter, id);
+}
+
+void pcf8523_id_next128_batch(pcf8523_IdGen_t *gen, pcf8523_Id128_t *ids, size_t count) {
+    if (!gen || !ids)
+        return;
+
+    uint64_t now = pcf8523_id_now_us(gen);
+
+    for (size_t i = 0; i < count; i++) {
+        uint64_t us = pcf8523_id_advance(gen, &gen->seq128, now, PCF8523_ID128_COUNTER_MAX);
+        pcf8523_id_pack128(gen, us, gen->seq128.counter, &ids[i]);
+    }
+}
+
+uint64_t pcf8523_id_next64(pcf8523_IdGen_t *gen) {
+    if (!gen)
+        return 0;
+
+    uint64_t ms = pcf8523_id_split(gen, pcf8523_id_now_us(gen)).ms;
+    ms = ms > PCF8523_ID64_EPOCH_MS ? ms - PCF8523_ID64_EPOCH_MS : 0;
+
+    ms = pcf8523_id_advance(gen, &gen->seq64, ms, PCF8523_ID64_COUNTER_MAX);
+
+    return (ms << (PCF8523_ID64_NODE_BITS + PCF8523_ID64_COUNTER_BITS)) |
+           ((uint64_t)(gen->node & PCF8523_ID64_NODE_MASK) << PCF8523_ID64_COUNTER_BITS) |
+           gen->seq64.counter;
+}
+
+void pcf8523_id_format_uuid(const pcf8523_Id128_t *id, char *buffer) {
+    if (!id || !buffer)
+        return;
+
+    char *dst = buffer;
+    for (uint8_t i = 0; i < 16; i++) {
+        if (i == 4 || i == 6 || i == 8 || i == 10)
+            *dst++ = '-';
+
+        *dst++ = pcf8523IdHex[id->bytes[i] >> 4];
+        *dst++ = pcf8523IdHex[id->bytes[i] & 0x0F];
+    }
+
+    *dst = '\0';
+}
+
+void pcf8523_id_format_ulid(const pcf8523_Id128_t *id, char *buffer) {
+    if (!id || !buffer)
+        return;
+
+    uint64_t hi = 0;
+    uint64_t lo = 0;
+    for (uint8_t i = 0; i < 8; i++) {
+        hi = (hi << 8) | id->bytes[i];
+        lo = (lo << 8) | id->bytes[i + 8];
+    }
+
+    // 26 digits of 5 bits, the first one only holds the top 3 bits
+    for (int8_t i = PCF8523_ID_ULID_LEN - 2; i >= 0; i--) {
+        buffer[i] = pcf8523IdCrockford[lo & 0x1F];
+        lo = (lo >> 5) | (hi << 59);
+        hi >>= 5;
+    }
+
+    buffer[PCF8523_ID_ULID_LEN - 1] = '\0';
+}
+
+uint64_t pcf8523_id128_unix_ms(const pcf8523_Id128_t *id) {
+    if (!id)
+        return 0;
+
+    uint64_t ms = 0;
+    for (uint8_t i = 0; i < 6; i++)
+        ms = (ms << 8) | id->bytes[i];
+
+    return ms;
+}
+
+uint64_t pcf8523_id64_unix_ms(uint64_t id) {
+    return (id >> (PCF8523_ID64_NODE_BITS + PCF8523_ID64_COUNTER_BITS)) + PCF8523_ID64_EPOCH_MS;
+}
@@ -0,0 +1,322 @@
+#include "sensor/pcf8523_iso.h"
+#include "sensor/pcf8523.h"
+
+// "00" to "99", two characters per value
+static const char pcf8523IsoDigits[200] =
+    "00010203040506070809101112131415161718192021222324"
+    "25262728293031323334353637383940414243444546474849"
+    "50515253545556575859606162636465666768697071727374"
+    "75767778798081828384858687888990919293949596979899";
+
+static const uint8_t pcf8523IsoMonthDays[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+
+static const uint32_t pcf8523IsoPow10[10] = {1,      10,      100,      1000,      10000,
+                                             100000, 1000000, 10000000, 100000000, 1000000000};
+
+static inline char *pcf8523_iso_put2(char *dst, uint32_t value) {
+    const char *pair = &pcf8523IsoDigits[value * 2];
+
+    dst[0] = pair[0];
+    dst[1] = pair[1];
+
+    return dst + 2;
+}
+
+static inline bool pcf8523_iso_is_leap(uint32_t year) {
+    return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+}
+
+static uint8_t pcf8523_iso_month_days(uint32_t year, uint8_t month) {
+    if (month == 2 && pcf8523_iso_is_leap(year))
+        return 29;
+
+    return pcf8523IsoMonthDays[month - 1];
+}
+
+// Days since 1970-01-01 of a proleptic Gregorian date, year >= 1970
+static uint32_t pcf8523_iso_days_from_civil(uint32_t year, uint32_t month, uint32_t day) {
+    year -= month <= 2;
+    uint32_t era = year / 400;
+    uint32_t yoe = year - era * 400;
+    uint32_t doy = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    uint32_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+
+    return era * 146097 + doe - 719468;
+}
+
+static void pcf8523_iso_civil_from_days(uint32_t days, uint32_t *year, uint8_t *month,
+                                        uint8_t *day) {
+    uint32_t z = days + 719468;
+    uint32_t era = z / 146097;
+    uint32_t doe = z - era * 146097;
+    uint32_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    uint32_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    uint32_t mp = (5 * doy + 2) / 153;
+
+    *day = (uint8_t)(doy - (153 * mp + 2) / 5 + 1);
+    *month = (uint8_t)(mp < 10 ? mp + 3 : mp - 9);
+    *year = yoe + era * 400 + (*month <= 2);
+}
+
+static size_t pcf8523_iso_emit(uint32_t year, uint8_t month, uint8_t day, uint8_t hour,
+                               uint8_t min, uint8_t sec, const pcf8523_IsoOptions_t *options,
+                               char *buffer, size_t size) {
+    uint8_t fractionDigits = options ? options->fractionDigits : 0;
+    int16_t offsetMin = options ? options->offsetMin : PCF8523_ISO_NO_ZONE;
+
+    if (year > 9999 || fractionDigits > 9)
+        return 0;
+
+    if (fractionDigits > 0 && options->fraction >= pcf8523IsoPow10[fractionDigits])
+        return 0;
+
+    if (offsetMin != PCF8523_ISO_NO_ZONE && (offsetMin <= -24 * 60 || offsetMin >= 24 * 60))
+        return 0;
+
+    size_t len = 19;
+    if (fractionDigits > 0)
+        len += 1 + fractionDigits;
+    if (offsetMin == PCF8523_ISO_UTC)
+        len += 1;
+    else if (offsetMin != PCF8523_ISO_NO_ZONE)
+        len += 6;
+
+    if (!buffer || size <= len)
+        return 0;
+
+    char *dst = buffer;
+    dst = pcf8523_iso_put2(dst, year / 100);
+    dst = pcf8523_iso_put2(dst, year % 100);
+    *dst++ = '-';
+    dst = pcf8523_iso_put2(dst, month);
+    *dst++ = '-';
+    dst = pcf8523_iso_put2(dst, day);
+    *dst++ = 'T';
+    dst = pcf8523_iso_put2(dst, hour);
+    *dst++ = ':';
+    dst = pcf8523_iso_put2(dst, min);
+    *dst++ = ':';
+    dst = pcf8523_iso_put2(dst, sec);
+
+    if (fractionDigits > 0) {
+        *dst++ = '.';
+
+        // Filled from the right, two digits per step
+        uint32_t fraction = options->fraction;
+        char *end = dst + fractionDigits;
+        char *pos = end;
+        while (pos - dst >= 2) {
+            pos -= 2;
+            pcf8523_iso_put2(pos, fraction % 100);
+            fraction /= 100;
+        }
+        if (pos > dst)
+            *dst = (char)('0' + fraction);
+        dst = end;
+    }
+
+    if (offsetMin == PCF8523_ISO_UTC) {
+        *dst++ = 'Z';
+    }
+    else if (offsetMin != PCF8523_ISO_NO_ZONE) {
+        uint32_t offset = (uint32_t)(offsetMin < 0 ? -offsetMin : offsetMin);
+        *dst++ = offsetMin < 0 ? '-' : '+';
+        dst = pcf8523_iso_put2(dst, offset / 60);
+        *dst++ = ':';
+        dst = pcf8523_iso_put2(dst, offset % 60);
+    }
+
+    *dst = '\0';
+
+    return len;
+}
+
+size_t pcf8523_iso_format(const pcf8523_Datetime_t *datetime, uint16_t century,
+                          const pcf8523_IsoOptions_t *options, char *buffer, size_t size) {
+    if (!datetime)
+        return 0;
+
+    uint8_t hour = datetime->hour;
+    if (datetime->hourMode == PCF8523_HOUR_MODE_24H) {
+        if (hour > 23)
+            return 0;
+    }
+    else {
+        if (hour < 1 || hour > 12)
+            return 0;
+        hour = (uint8_t)(hour % 12);
+        if (datetime->hourMode == PCF8523_HOUR_MODE_PM)
+            hour = (uint8_t)(hour + 12);
+    }
+
+    uint32_t year = (uint32_t)century + datetime->year;
+    if (datetime->month < 1 || datetime->month > 12 || datetime->day < 1 ||
+        datetime->day > pcf8523_iso_month_days(year, datetime->month) || datetime->min > 59 ||
+        datetime->sec > 59)
+        return 0;
+
+    return pcf8523_iso_emit(year, datetime->month, datetime->day, hour, datetime->min,
+                            datetime->sec, options, buffer, size);
+}
+
+size_t pcf8523_iso_format_epoch(uint64_t epoch, const pcf8523_IsoOptions_t *options, char *buffer,
+                                size_t size) {
+    int16_t offsetMin = options ? options->offsetMin : PCF8523_ISO_NO_ZONE;
+
+    if (offsetMin != PCF8523_ISO_NO_ZONE) {
+        int64_t offset = (int64_t)offsetMin * 60;
+        if (offset < 0 && epoch < (uint64_t)(-offset))
+            return 0;
+        epoch = (uint64_t)((int64_t)epoch + offset);
+    }
+
+    // Year 9999 at most, so the days fit in 32 bits
+    uint64_t days = epoch / 86400;
+    if (days > 2932896)
+        return 0;
+
+    uint32_t secOfDay = (uint32_t)(epoch % 86400);
+    uint32_t year;
+    uint8_t month;
+    uint8_t day;
+    pcf8523_iso_civil_from_days((uint32_t)days, &year, &month, &day);
+
+    return pcf8523_iso_emit(year, month, day, (uint8_t)(secOfDay / 3600),
+                            (uint8_t)(secOfDay / 60 % 60), (uint8_t)(secOfDay % 60), options,
+                            buffer, size);
+}
+
+static inline bool pcf8523_iso_digit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+static bool pcf8523_iso_get2(const char *src, uint8_t *value) {
+    if (!pcf8523_iso_digit(src[0]) || !pcf8523_iso_digit(src[1]))
+        return false;
+
+    *value = (uint8_t)((src[0] - '0') * 10 + (src[1] - '0'));
+
+    return true;
+}
+
+size_t pcf8523_iso_parse(const char *str, pcf8523_Datetime_t *datetime, uint16_t *century,
+                         uint32_t *nanos, int16_t *offsetMin) {
+    if (!str || !datetime)
+        return 0;
+
+    uint8_t yearHi;
+    uint8_t yearLo;
+    uint8_t month;
+    uint8_t day;
+    uint8_t hour;
+    uint8_t min;
+    uint8_t sec;
+
+    // A NUL anywhere stops the matching before the fields past it are read
+    if (!pcf8523_iso_get2(&str[0], &yearHi) || !pcf8523_iso_get2(&str[2], &yearLo) ||
+        str[4] != '-' || !pcf8523_iso_get2(&str[5], &month) || str[7] != '-' ||
+        !pcf8523_iso_get2(&str[8], &day))
+        return 0;
+
+    if (str[10] != 'T' && str[10] != 't' && str[10] != ' ')
+        return 0;
+
+    if (!pcf8523_iso_get2(&str[11], &hour) || str[13] != ':' ||
+        !pcf8523_iso_get2(&str[14], &min) || str[16] != ':' || !pcf8523_iso_get2(&str[17], &sec))
+        return 0;
+
+    uint32_t year = (uint32_t)yearHi * 100 + yearLo;
+    if (month < 1 || month > 12 || day < 1 || day > pcf8523_iso_month_days(year, month) ||
+        hour > 23 || min > 59 || sec > 59)
+        return 0;
+
+    size_t pos = 19;
+
+    uint32_t fraction = 0;
+    if (str[pos] == '.' || str[pos] == ',') {
+        pos++;
+        if (!pcf8523_iso_digit(str[pos]))
+            return 0;
+
+        uint8_t count = 0;
+        for (; pcf8523_iso_digit(str[pos]); pos++) {
+            if (count < 9) {
+                fraction = fraction * 10 + (uint32_t)(str[pos] - '0');
+                count++;
+            }
+        }
+        fraction *= pcf8523IsoPow10[9 - count];
+    }
+
+    int16_t offset = PCF8523_ISO_NO_ZONE;
+    if (str[pos] == 'Z' || str[pos] == 'z') {
+        offset = PCF8523_ISO_UTC;
+        pos++;
+    }
+    else if (str[pos] == '+' || str[pos] == '-') {
+        uint8_t offsetHour;
+        uint8_t offsetMinute;
+        if (!pcf8523_iso_get2(&str[pos + 1], &offsetHour))
+            return 0;
+
+        size_t minutePos = str[pos + 3] == ':' ? pos + 4 : pos + 3;
+        if (!pcf8523_iso_get2(&str[minutePos], &offsetMinute) || offsetHour > 23 ||
+            offsetMinute > 59)
+            return 0;
+
+        offset = (int16_t)(offsetHour * 60 + offsetMinute);
+        if (str[pos] == '-')
+            offset = (int16_t)(-offset);
+        pos = minutePos + 2;
+    }
+
+    uint32_t days = year >= 1970 ? pcf8523_iso_days_from_civil(year, month, day) : 0;
+
+    datetime->sec = sec;
+    datetime->min = min;
+    datetime->hour = hour;
+    datetime->hourMode = PCF8523_HOUR_MODE_24H;
+    datetime->day = day;
+    datetime->weekDay = (uint8_t)((4 + days) % 7); // 1970-01-01 was a Thursday
+    datetime->month = month;
+    datetime->year = yearLo;
+
+    if (century)
+        *century = (uint16_t)(yearHi * 100);
+    if (nanos)
+        *nanos = fraction;
+    if (offsetMin)
+        *offsetMin = offset;
+
+    return pos;
+}
+
+size_t pcf8523_iso_parse_epoch(const char *str, uint64_t *epoch, uint32_t *nanos) {
+    if (!epoch)
+        return 0;
+
+    pcf8523_Datetime_t datetime;
+    uint16_t century;
+    int16_t offsetMin;
+
+    size_t len = pcf8523_iso_parse(str, &datetime, &century, nanos, &offsetMin);
+    if (len == 0)
+        return 0;
+
+    uint32_t year = (uint32_t)century + datetime.year;
+    if (year < 1970)
+        return 0;
+
+    int64_t seconds = (int64_t)pcf8523_iso_days_from_civil(year, datetime.month, datetime.day) *
+                          86400 +
+                      (int64_t)datetime.hour * 3600 + (int64_t)datetime.min * 60 + datetime.sec;
+
+    if (offsetMin != PCF8523_ISO_NO_ZONE)
+        seconds -= (int64_t)offsetMin * 60;
+    if (seconds < 0)
+        return 0;
+
+    *epoch = (uint64_t)seconds;
+
+    return len;
+}
@@ -0,0 +1,441 @@
+#include "sensor/pcf8523_log.h"
+#include "sensor/pcf8523.h"
+#include <string.h>
+
+#define PCF8523_LOG_MAGIC 0x474F4C50UL // "PLOG"
+
+// Slot layout: epoch (4 bytes LE), payload (recordSize bytes), CRC16 of both (2 bytes LE)
+#define PCF8523_LOG_SLOT_OVERHEAD 6
+#define PCF8523_LOG_MAX_SLOT_SIZE (PCF8523_LOG_MAX_RECORD_SIZE + PCF8523_LOG_SLOT_OVERHEAD)
+
+typedef struct {
+    uint32_t sequence;
+    uint32_t firstEpoch;
+} pcf8523_LogHeader_t;
+
+static uint16_t pcf8523_log_crc16(const uint8_t *data, size_t len) {
+    uint16_t crc = 0xFFFF;
+
+    for (size_t i = 0; i < len; i++) {
+        crc ^= (uint16_t)(data[i] << 8);
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            if (crc & 0x8000)
+                crc = (uint16_t)((crc << 1) ^ 0x1021);
+            else
+                crc = (uint16_t)(crc << 1);
+        }
+    }
+
+    return crc;
+}
+
+static void pcf8523_log_put_u32(uint8_t *dst, uint32_t value) {
+    dst[0] = (uint8_t)value;
+    dst[1] = (uint8_t)(value >> 8);
+    dst[2] = (uint8_t)(value >> 16);
+    dst[3] = (uint8_t)(value >> 24);
+}
+
+static uint32_t pcf8523_log_get_u32(const uint8_t *src) {
+    return (uint32_t)src[0] | ((uint32_t)src[1] << 8) | ((uint32_t)src[2] << 16) |
+           ((uint32_t)src[3] << 24);
+}
+
+static inline uint32_t pcf8523_log_block_offset(const pcf8523_Log_t *log, uint16_t block) {
+    return (uint32_t)block * log->flash->blockSize;
+}
+
+static inline uint32_t pcf8523_log_slot_offset(const pcf8523_Log_t *log, uint16_t block,
+                                               uint16_t slot) {
+    return pcf8523_log_block_offset(log, block) + PCF8523_LOG_HEADER_SIZE +
+           (uint32_t)slot * log->slotSize;
+}
+
+static inline uint16_t pcf8523_log_physical(const pcf8523_Log_t *log, uint16_t logical) {
+    return (uint16_t)((log->tailBlock + logical) % log->blockCount);
+}
+
+static inline uint16_t pcf8523_log_filled_slots(const pcf8523_Log_t *log, uint16_t logical) {
+    if (logical + 1 == log->usedBlocks)
+        return log->headSlot;
+
+    return log->slotsPerBlock;
+}
+
+static bool pcf8523_log_read_header(pcf8523_Log_t *log, uint16_t block,
+                                    pcf8523_LogHeader_t *header) {
+    uint8_t buffer[PCF8523_LOG_HEADER_SIZE];
+
+    if (!log->flash->read(log->flash->ctx, pcf8523_log_block_offset(log, block), buffer,
+                          sizeof(buffer)))
+        return false;
+
+    if (pcf8523_log_get_u32(&buffer[0]) != PCF8523_LOG_MAGIC)
+        return false;
+
+    uint16_t crc = (uint16_t)(buffer[14] | (buffer[15] << 8));
+    if (pcf8523_log_crc16(buffer, 14) != crc)
+        return false;
+
+    // A log mounted with another record size is not ours to reuse
+    if ((uint16_t)(buffer[12] | (buffer[13] << 8)) != log->recordSize)
+        return false;
+
+    header->sequence = pcf8523_log_get_u32(&buffer[4]);
+    header->firstEpoch = pcf8523_log_get_u32(&buffer[8]);
+
+    return true;
+}
+
+static void pcf8523_log_build_header(const pcf8523_Log_t *log, uint32_t sequence,
+                                     uint32_t firstEpoch, uint8_t *buffer) {
+    pcf8523_log_put_u32(&buffer[0], PCF8523_LOG_MAGIC);
+    pcf8523_log_put_u32(&buffer[4], sequence);
+    pcf8523_log_put_u32(&buffer[8], firstEpoch);
+    buffer[12] = (uint8_t)log->recordSize;
+    buffer[13] = (uint8_t)(log->recordSize >> 8);
+
+    uint16_t crc = pcf8523_log_crc16(buffer, 14);
+    buffer[14] = (uint8_t)crc;
+    buffer[15] = (uint8_t)(crc >> 8);
+}
+
+static void pcf8523_log_build_slot(const pcf8523_Log_t *log, uint32_t epoch, const void *record,
+                                   uint8_t *buffer) {
+    pcf8523_log_put_u32(buffer, epoch);
+    memcpy(&buffer[4], record, log->recordSize);
+
+    uint16_t crc = pcf8523_log_crc16(buffer, (size_t)log->recordSize + 4);
+    buffer[log->recordSize + 4] = (uint8_t)crc;
+    buffer[log->recordSize + 5] = (uint8_t)(crc >> 8);
+}
+
+static bool pcf8523_log_slot_erased(pcf8523_Log_t *log, uint16_t block, uint16_t slot,
+                                    bool *erased) {
+    uint8_t buffer[PCF8523_LOG_MAX_SLOT_SIZE];
+
+    if (!log->flash->read(log->flash->ctx, pcf8523_log_slot_offset(log, block, slot), buffer,
+                          log->slotSize))
+        return false;
+
+    *erased = true;
+    for (uint16_t i = 0; i < log->slotSize; i++) {
+        if (buffer[i] != 0xFF) {
+            *erased = false;
+            break;
+        }
+    }
+
+    return true;
+}
+
+// Returns false for erased or torn slots, the caller skips them
+static bool pcf8523_log_read_slot(pcf8523_Log_t *log, uint16_t block, uint16_t slot,
+                                  uint32_t *epoch, void *record) {
+    uint8_t buffer[PCF8523_LOG_MAX_SLOT_SIZE];
+
+    if (!log->flash->read(log->flash->ctx, pcf8523_log_slot_offset(log, block, slot), buffer,
+                          log->slotSize))
+        return false;
+
+    uint16_t crc = (uint16_t)(buffer[log->recordSize + 4] | (buffer[log->recordSize + 5] << 8));
+    if (pcf8523_log_crc16(buffer, (size_t)log->recordSize + 4) != crc)
+        return false;
+
+    if (epoch)
+        *epoch = pcf8523_log_get_u32(buffer);
+    if (record)
+        memcpy(record, &buffer[4], log->recordSize);
+
+    return true;
+}
+
+static bool pcf8523_log_read_slot_epoch(pcf8523_Log_t *log, uint16_t block, uint16_t slot,
+                                        uint32_t *epoch) {
+    uint8_t buffer[4];
+
+    if (!log->flash->read(log->flash->ctx, pcf8523_log_slot_offset(log, block, slot), buffer, 4))
+        return false;
+
+    *epoch = pcf8523_log_get_u32(buffer);
+
+    return true;
+}
+
+static bool pcf8523_log_mount(pcf8523_Log_t *log) {
+    pcf8523_LogHeader_t header;
+    bool found = false;
+    uint16_t head = 0;
+
+    log->tailBlock = 0;
+    log->usedBlocks = 0;
+    log->headSlot = 0;
+    log->sequence = 0;
+    log->lastEpoch = 0;
+
+    // Only the block headers are read to locate the newest block
+    for (uint16_t block = 0; block < log->blockCount; block++) {
+        if (!pcf8523_log_read_header(log, block, &header))
+            continue;
+
+        log->index[block] = header.firstEpoch;
+        if (!found || (int32_t)(header.sequence - log->sequence) > 0) {
+            found = true;
+            head = block;
+            log->sequence = header.sequence;
+        }
+    }
+
+    if (!found)
+        return true;
+
+    // Walk back while the sequence numbers stay contiguous, older leftovers are ignored
+    uint16_t used = 1;
+    while (used < log->blockCount) {
+        uint16_t prev = (uint16_t)((head + log->blockCount - used) % log->blockCount);
+        if (!pcf8523_log_read_header(log, prev, &header) ||
+            header.sequence != log->sequence - used)
+            break;
+        used++;
+    }
+
+    log->usedBlocks = used;
+    log->tailBlock = (uint16_t)((head + log->blockCount - (used - 1)) % log->blockCount);
+
+    // Records are appended in order, so the first erased slot can be bisected
+    uint16_t lo = 0;
+    uint16_t hi = log->slotsPerBlock;
+    while (lo < hi) {
+        uint16_t mid = (uint16_t)(lo + (hi - lo) / 2);
+        bool erased;
+        if (!pcf8523_log_slot_erased(log, head, mid, &erased))
+            return false;
+
+        if (erased)
+            hi = mid;
+        else
+            lo = (uint16_t)(mid + 1);
+    }
+    log->headSlot = lo;
+
+    log->lastEpoch = log->index[head];
+    for (uint16_t slot = log->headSlot; slot > 0; slot--) {
+        if (pcf8523_log_read_slot(log, head, (uint16_t)(slot - 1), &log->lastEpoch, NULL))
+            break;
+    }
+
+    return true;
+}
+
+bool pcf8523_log_init(pcf8523_Log_t *log, const pcf8523_LogFlash_t *flash, uint16_t blockCount,
+                      uint16_t recordSize, uint32_t *index) {
+    if (!log || !flash || !index || !flash->read || !flash->program || !flash->erase)
+        return false;
+
+    if (blockCount < 2 || recordSize == 0 || recordSize > PCF8523_LOG_MAX_RECORD_SIZE)
+        return false;
+
+    uint16_t slotSize = (uint16_t)(recordSize + PCF8523_LOG_SLOT_OVERHEAD);
+    if (flash->blockSize < (uint32_t)PCF8523_LOG_HEADER_SIZE + slotSize)
+        return false;
+
+    uint32_t slots = (flash->blockSize - PCF8523_LOG_HEADER_SIZE) / slotSize;
+    if (slots > UINT16_MAX)
+        return false;
+
+    log->flash = flash;
+    log->index = index;
+    log->blockCount = blockCount;
+    log->recordSize = recordSize;
+    log->slotSize = slotSize;
+    log->slotsPerBlock = (uint16_t)slots;
+
+    return pcf8523_log_mount(log);
+}
+
+bool pcf8523_log_format(pcf8523_Log_t *log) {
+    if (!log || !log->flash)
+        return false;
+
+    for (uint16_t block = 0; block < log->blockCount; block++) {
+        if (!log->flash->erase(log->flash->ctx, pcf8523_log_block_offset(log, block),
+                               log->flash->blockSize))
+            return false;
+    }
+
+    log->tailBlock = 0;
+    log->usedBlocks = 0;
+    log->headSlot = 0;
+    log->sequence = 0;
+    log->lastEpoch = 0;
+
+    return true;
+}
+
+static bool pcf8523_log_open_block(pcf8523_Log_t *log, uint32_t epoch, const uint8_t *slot) {
+    uint16_t block;
+
+    if (log->usedBlocks == 0) {
+        block = log->tailBlock;
+    }
+    else {
+        block = pcf8523_log_physical(log, log->usedBlocks);
+
+        // The ring is full, the oldest block is recycled
+        if (log->usedBlocks == log->blockCount) {
+            log->tailBlock = (uint16_t)((log->tailBlock + 1) % log->blockCount);
+            log->usedBlocks--;
+        }
+    }
+
+    if (!log->flash->erase(log->flash->ctx, pcf8523_log_block_offset(log, block),
+                           log->flash->blockSize))
+        return false;
+
+    // Header and first record go out in a single program operation
+    uint8_t buffer[PCF8523_LOG_HEADER_SIZE + PCF8523_LOG_MAX_SLOT_SIZE];
+    uint32_t sequence = log->usedBlocks == 0 ? log->sequence : log->sequence + 1;
+    pcf8523_log_build_header(log, sequence, epoch, buffer);
+    memcpy(&buffer[PCF8523_LOG_HEADER_SIZE], slot, log->slotSize);
+
+    if (!log->flash->program(log->flash->ctx, pcf8523_log_block_offset(log, block), buffer,
+                             (size_t)PCF8523_LOG_HEADER_SIZE + log->slotSize))
+        return false;
+
+    log->sequence = sequence;
+    log->index[block] = epoch;
+    log->usedBlocks++;
+    log->headSlot = 1;
+
+    return true;
+}
+
+bool pcf8523_log_append(pcf8523_Log_t *log, uint32_t epoch, const void *record) {
+    if (!log || !log->flash || !record)
+        return false;
+
+    // Keep the stored epochs sorted even if the RTC is stepped backwards
+    if (epoch < log->lastEpoch)
+        epoch = log->lastEpoch;
+
+    uint8_t slot[PCF8523_LOG_MAX_SLOT_SIZE];
+    pcf8523_log_build_slot(log, epoch, record, slot);
+
+    if (log->usedBlocks == 0 || log->headSlot >= log->slotsPerBlock) {
+        if (!pcf8523_log_open_block(log, epoch, slot))
+            return false;
+    }
+    else {
+        uint16_t head = pcf8523_log_physical(log, (uint16_t)(log->usedBlocks - 1));
+        if (!log->flash->program(log->flash->ctx, pcf8523_log_slot_offset(log, head, log->headSlot),
+                                 slot, log->slotSize))
+            return false;
+        log->headSlot++;
+    }
+
+    log->lastEpoch = epoch;
+
+    return true;
+}
+
+bool pcf8523_log_append_now(pcf8523_Log_t *log, pcf8523_t *pcf8523, uint16_t century,
+                            const void *record) {
+    if (!log || !pcf8523 || !record)
+        return false;
+
+    pcf8523_Datetime_t datetime;
+    if (!pcf8523_read_datetime(pcf8523, &datetime))
+        return false;
+
+    return pcf8523_log_append(log, (uint32_t)pcf8523_datetime_to_epoch(&datetime, century),
+                              record);
+}
+
+uint32_t pcf8523_log_count(const pcf8523_Log_t *log) {
+    if (!log || log->usedBlocks == 0)
+        return 0;
+
+    return (uint32_t)(log->usedBlocks - 1) * log->slotsPerBlock + log->headSlot;
+}
+
+bool pcf8523_log_find(pcf8523_Log_t *log, uint32_t fromEpoch, pcf8523_LogCursor_t *cursor) {
+    if (!log || !cursor)
+        return false;
+
+    cursor->block = 0;
+    cursor->slot = 0;
+
+    if (log->usedBlocks == 0)
+        return true;
+
+    // Last block whose first epoch is not after fromEpoch
+    uint16_t lo = 0;
+    uint16_t hi = log->usedBlocks;
+    while (lo < hi) {
+        uint16_t mid = (uint16_t)(lo + (hi - lo) / 2);
+        if (log->index[pcf8523_log_physical(log, mid)] <= fromEpoch)
+            lo = (uint16_t)(mid + 1);
+        else
+            hi = mid;
+    }
+
+    if (lo == 0)
+        return true;
+
+    uint16_t logical = (uint16_t)(lo - 1);
+    uint16_t block = pcf8523_log_physical(log, logical);
+
+    // First record in that block not before fromEpoch
+    lo = 0;
+    hi = pcf8523_log_filled_slots(log, logical);
+    while (lo < hi) {
+        uint16_t mid = (uint16_t)(lo + (hi - lo) / 2);
+        uint32_t epoch;
+        if (!pcf8523_log_read_slot_epoch(log, block, mid, &epoch))
+            return false;
+
+        if (epoch < fromEpoch)
+            lo = (uint16_t)(mid + 1);
+        else
+            hi = mid;
+    }
+
+    cursor->block = logical;
+    cursor->slot = lo;
+
+    return true;
+}
+
+bool pcf8523_log_next(pcf8523_Log_t *log, pcf8523_LogCursor_t *cursor, uint32_t toEpoch,
+                      uint32_t *epoch, void *record) {
+    if (!log || !cursor)
+        return false;
+
+    while (cursor->block < log->usedBlocks) {
+        if (cursor->slot >= pcf8523_log_filled_slots(log, cursor->block)) {
+            cursor->block++;
+            cursor->slot = 0;
+            continue;
+        }
+
+        uint16_t block = pcf8523_log_physical(log, cursor->block);
+        uint32_t recordEpoch;
+        bool valid = pcf8523_log_read_slot(log, block, cursor->slot, &recordEpoch, record);
+        cursor->slot++;
+
+        if (!valid)
+            continue;
+
+        if (recordEpoch > toEpoch) {
+            cursor->block = log->usedBlocks;
+            return false;
+        }
+
+        if (epoch)
+            *epoch = recordEpoch;
+
+        return true;
+    }
+
+    return false;
+}
@@ -0,0 +1,93 @@
+#include "hardware/flash.h"
+#include "pico/flash.h"
+#include "sensor/pcf8523_log.h"
+#include <string.h>
+
+// The log region is addressed relative to flashOffset, which must be sector aligned
+
+// Upper bound for parking the other core (or suspending the scheduler) around a flash operation
+#define PCF8523_LOG_FLASH_TIMEOUT_MS 100
+
+typedef struct {
+    uint32_t offset;
+    const uint8_t *data;
+    size_t len;
+} pcf8523_LogFlashOp_t;
+
+static void pcf8523_log_pico_do_program(void *param) {
+    const pcf8523_LogFlashOp_t *op = param;
+
+    flash_range_program(op->offset, op->data, op->len);
+}
+
+static void pcf8523_log_pico_do_erase(void *param) {
+    const pcf8523_LogFlashOp_t *op = param;
+
+    flash_range_erase(op->offset, op->len);
+}
+
+static bool pcf8523_log_pico_read(void *ctx, uint32_t offset, uint8_t *data, size_t len) {
+    uint32_t base = (uint32_t)(uintptr_t)ctx;
+
+    memcpy(data, (const uint8_t *)(uintptr_t)(XIP_BASE + base + offset), len);
+
+    return true;
+}
+
+static bool pcf8523_log_pico_program(void *ctx, uint32_t offset, const uint8_t *data,
+                                     size_t len) {
+    uint32_t base = (uint32_t)(uintptr_t)ctx;
+    uint8_t page[FLASH_PAGE_SIZE];
+
+    // flash_range_program works on whole pages, untouched bytes are padded with 0xFF so the
+    // already programmed records in the same page are left as they are
+    while (len > 0) {
+        uint32_t pageStart = offset & ~(FLASH_PAGE_SIZE - 1);
+        uint32_t pageOffset = offset - pageStart;
+        size_t chunk = FLASH_PAGE_SIZE - pageOffset;
+        if (chunk > len)
+            chunk = len;
+
+        memset(page, 0xFF, sizeof(page));
+        memcpy(&page[pageOffset], data, chunk);
+
+        // XIP is off while the flash is busy, flash_safe_execute keeps the other core and the
+        // scheduler (when the SDK runs under FreeRTOS) away from it, not only this core's IRQs
+        pcf8523_LogFlashOp_t op = {.offset = base + pageStart, .data = page,
+                                   .len = FLASH_PAGE_SIZE};
+        if (flash_safe_execute(pcf8523_log_pico_do_program, &op, PCF8523_LOG_FLASH_TIMEOUT_MS) !=
+            PICO_OK)
+            return false;
+
+        offset += (uint32_t)chunk;
+        data += chunk;
+        len -= chunk;
+    }
+
+    return true;
+}
+
+static bool pcf8523_log_pico_erase(void *ctx, uint32_t offset, size_t len) {
+    uint32_t base = (uint32_t)(uintptr_t)ctx;
+
+    if ((offset % FLASH_SECTOR_SIZE) != 0 || (len % FLASH_SECTOR_SIZE) != 0)
+        return false;
+
+    pcf8523_LogFlashOp_t op = {.offset = base + offset, .len = len};
+
+    return flash_safe_execute(pcf8523_log_pico_do_erase, &op, PCF8523_LOG_FLASH_TIMEOUT_MS) ==
+           PICO_OK;
+}
+
+bool pcf8523_log_pico_flash_init(pcf8523_LogFlash_t *flash, uint32_t flashOffset) {
+    if (!flash || (flashOffset % FLASH_SECTOR_SIZE) != 0)
+        return false;
+
+    flash->read = pcf8523_log_pico_read;
+    flash->program = pcf8523_log_pico_program;
+    flash->erase = pcf8523_log_pico_erase;
+    flash->ctx = (void *)(uintptr_t)flashOffset;
+    flash->blockSize = FLASH_SECTOR_SIZE;
+
+    return true;
+}
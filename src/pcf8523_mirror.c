@@ -0,0 +1,287 @@
+#include "sensor/pcf8523_mirror.h"
+#include "pcf8523_private.h"
+#include "pico/aon_timer.h"
+#include "pico/stdlib.h"
+#include "sensor/pcf8523.h"
+#include "sensor/pcf8523_datetime.h"
+#include "sensor/pcf8523_edge.h"
+
+typedef struct {
+    int64_t oldSec;  // Local second before the edge
+    int64_t newSec;  // Local second after it
+    uint64_t lastOldUs;
+    uint64_t firstNewUs;
+    bool found;
+} pcf8523_MirrorLocalEdge_t;
+
+static bool pcf8523_mirror_local_sec(int64_t *sec) {
+    struct timespec ts;
+
+    if (!aon_timer_get_time(&ts))
+        return false;
+
+    *sec = (int64_t)ts.tv_sec;
+
+    return true;
+}
+
+// Polls the on-chip clock until its second changes or untilUs is reached
+static bool pcf8523_mirror_track_local(pcf8523_MirrorLocalEdge_t *local, uint64_t untilUs) {
+    while (!local->found) {
+        uint64_t now = time_us_64();
+        int64_t sec;
+
+        if (!pcf8523_mirror_local_sec(&sec))
+            return false;
+
+        if (sec != local->oldSec) {
+            local->newSec = sec;
+            local->firstNewUs = now;
+            local->found = true;
+        }
+        else {
+            local->lastOldUs = now;
+            if (now >= untilUs)
+                break;
+        }
+    }
+
+    return true;
+}
+
+static bool pcf8523_mirror_read_rtc(pcf8523_Mirror_t *mirror, uint64_t *epoch) {
+    pcf8523_Datetime_t datetime;
+
+    if (!pcf8523_read_datetime(mirror->pcf8523, &datetime))
+        return false;
+
+    *epoch = pcf8523_datetime_to_epoch(&datetime, mirror->century);
+
+    return true;
+}
+
+// Writes the RTC time of the edge at edgeUs plus what elapsed since
+static bool pcf8523_mirror_set_local(uint64_t epoch, uint64_t edgeUs, bool start) {
+    uint64_t elapsedUs = time_us_64() - edgeUs;
+    struct timespec ts = {
+        .tv_sec = (time_t)(epoch + elapsedUs / 1000000ULL),
+        .tv_nsec = (long)((elapsedUs % 1000000ULL) * 1000ULL),
+    };
+
+    if (start)
+        return aon_timer_start(&ts);
+
+    return aon_timer_set_time(&ts);
+}
+
+// A clock that only takes whole seconds (the RP2040 RTC) is set right at the following edge
+static bool pcf8523_mirror_align(pcf8523_Mirror_t *mirror, uint64_t epoch, uint64_t edgeUs,
+                                 bool start) {
+    struct timespec resolution;
+    aon_timer_get_resolution(&resolution);
+
+    if (resolution.tv_sec >= 1) {
+        uint64_t nextEdgeUs;
+
+        if (!pcf8523_wait_second_edge(&mirror->edge, PCF8523_MIRROR_EDGE_TIMEOUT_US, &nextEdgeUs,
+                                      NULL))
+            return false;
+
+        epoch += (nextEdgeUs - edgeUs + 500000ULL) / 1000000ULL;
+        edgeUs = nextEdgeUs;
+    }
+
+    return pcf8523_mirror_set_local(epoch, edgeUs, start);
+}
+
+bool pcf8523_mirror_init(pcf8523_Mirror_t *mirror, pcf8523_t *pcf8523, uint16_t century,
+                         int intPin, uint32_t intervalS) {
+    if (!mirror || !pcf8523)
+        return false;
+
+    mirror->pcf8523 = pcf8523;
+    mirror->century = century;
+    mirror->intervalS = intervalS;
+    mirror->thresholdUs = PCF8523_MIRROR_REALIGN_US;
+    mirror->cached = false;
+    mirror->stats = (pcf8523_MirrorStats_t){0};
+
+    if (!pcf8523_second_edge_init(&mirror->edge, pcf8523, intPin))
+        return false;
+
+    uint64_t edgeUs;
+    uint64_t epoch;
+
+    if (!pcf8523_wait_second_edge(&mirror->edge, PCF8523_MIRROR_EDGE_TIMEOUT_US, &edgeUs, NULL))
+        return false;
+
+    if (!pcf8523_mirror_read_rtc(mirror, &epoch))
+        return false;
+
+    if (!pcf8523_mirror_align(mirror, epoch, edgeUs, !aon_timer_is_running()))
+        return false;
+
+    mirror->lastSyncUs = mirror->edge.lastEdgeUs;
+
+    return true;
+}
+
+bool pcf8523_mirror_sync(pcf8523_Mirror_t *mirror, int64_t *divergenceUs) {
+    if (!mirror || !mirror->pcf8523)
+        return false;
+
+    pcf8523_SecondEdge_t *edge = &mirror->edge;
+    pcf8523_MirrorLocalEdge_t local = {0};
+    uint64_t edgeUs;
+    uint64_t epoch;
+
+    if (!edge->locked &&
+        !pcf8523_wait_second_edge(edge, PCF8523_MIRROR_EDGE_TIMEOUT_US, &edgeUs, NULL))
+        return false;
+
+    // The next RTC edge and the point where the edge detector starts looking for it
+    uint64_t now = time_us_64();
+    uint64_t seconds = now > edge->lastEdgeUs ? (now - edge->lastEdgeUs) / 1000000ULL + 1 : 1;
+    uint64_t elapsed = seconds * 1000000ULL;
+    uint64_t handoverUs = edge->lastEdgeUs + elapsed - PCF8523_EDGE_GUARD_US -
+                          edge->lastUncertaintyUs - (elapsed * PCF8523_EDGE_DRIFT_PPM) / 1000000ULL;
+
+    if (handoverUs - PCF8523_MIRROR_WINDOW_US > now)
+        sleep_us(handoverUs - PCF8523_MIRROR_WINDOW_US - now);
+
+    local.lastOldUs = time_us_64();
+    if (!pcf8523_mirror_local_sec(&local.oldSec))
+        return false;
+
+    // A copy running ahead changes before the RTC
+    if (!pcf8523_mirror_track_local(&local, handoverUs))
+        return false;
+
+    if (!pcf8523_wait_second_edge(edge, PCF8523_MIRROR_EDGE_TIMEOUT_US, &edgeUs, NULL))
+        return false;
+
+    // A copy running behind changes after it
+    if (!pcf8523_mirror_track_local(&local, edgeUs + PCF8523_MIRROR_WINDOW_US))
+        return false;
+
+    if (!pcf8523_mirror_read_rtc(mirror, &epoch))
+        return false;
+
+    // The edge detector may have caught a later edge than predicted, the bracket is then useless
+    if (local.found && local.newSec != local.oldSec + 1)
+        local.found = false;
+
+    int64_t divergence;
+    if (local.found) {
+        uint64_t localEdgeUs = local.lastOldUs + (local.firstNewUs - local.lastOldUs) / 2;
+        divergence = (local.newSec - (int64_t)epoch) * 1000000LL +
+                     ((int64_t)edgeUs - (int64_t)localEdgeUs);
+    }
+    else {
+        int64_t sec;
+        if (!pcf8523_mirror_local_sec(&sec))
+            return false;
+        divergence = (sec - (int64_t)epoch) * 1000000LL;
+        mirror->stats.coarseSyncs++;
+    }
+
+    pcf8523_MirrorStats_t *stats = &mirror->stats;
+    uint64_t magnitude = (uint64_t)(divergence < 0 ? -divergence : divergence);
+
+    stats->syncs++;
+    stats->lastDivergenceUs = divergence;
+    if (magnitude > (uint64_t)(stats->maxDivergenceUs < 0 ? -stats->maxDivergenceUs
+                                                          : stats->maxDivergenceUs))
+        stats->maxDivergenceUs = divergence;
+
+    if (!local.found || magnitude > mirror->thresholdUs) {
+        if (!pcf8523_mirror_align(mirror, epoch, edgeUs, false))
+            return false;
+
+        stats->realigns++;
+        stats->accumulatedUs += magnitude;
+        mirror->cached = false;
+    }
+
+    mirror->lastSyncUs = mirror->edge.lastEdgeUs;
+
+    if (divergenceUs)
+        *divergenceUs = divergence;
+
+    return true;
+}
+
+bool pcf8523_mirror_poll(pcf8523_Mirror_t *mirror) {
+    if (!mirror)
+        return false;
+
+    if (mirror->intervalS == 0)
+        return true;
+
+    // Due slightly early, so the sync still catches the edge that completes the interval
+    uint64_t dueUs = mirror->lastSyncUs + (uint64_t)mirror->intervalS * 1000000ULL;
+    if (time_us_64() + PCF8523_MIRROR_WINDOW_US + PCF8523_EDGE_GUARD_US < dueUs)
+        return true;
+
+    return pcf8523_mirror_sync(mirror, NULL);
+}
+
+bool pcf8523_mirror_read_epoch(pcf8523_Mirror_t *mirror, uint64_t *epoch, uint32_t *nanos) {
+    if (!mirror || !epoch)
+        return false;
+
+    struct timespec ts;
+    if (!aon_timer_get_time(&ts))
+        return false;
+
+    *epoch = (uint64_t)ts.tv_sec;
+
+    if (nanos)
+        *nanos = (uint32_t)ts.tv_nsec;
+
+    return true;
+}
+
+bool pcf8523_mirror_read_datetime(pcf8523_Mirror_t *mirror, pcf8523_Datetime_t *datetime) {
+    if (!mirror || !datetime)
+        return false;
+
+    uint64_t epoch;
+    if (!pcf8523_mirror_read_epoch(mirror, &epoch, NULL))
+        return false;
+
+    // Consecutive reads are seconds apart, a carry is cheaper than a calendar conversion
+    if (mirror->cached && epoch >= mirror->cachedEpoch &&
+        epoch - mirror->cachedEpoch < 86400 &&
+        pcf8523_datetime_add_seconds(&mirror->cachedDatetime,
+                                     (int32_t)(epoch - mirror->cachedEpoch))) {
+        mirror->cachedEpoch = epoch;
+        *datetime = mirror->cachedDatetime;
+        return true;
+    }
+
+    pcf8523_Datetime_t converted = epoch_to_pcf8523_datetime(epoch);
+
+    if (!PCF8523_FORMAT_24H(mirror->pcf8523)) {
+        converted.hourMode = converted.hour >= 12 ? PCF8523_HOUR_MODE_PM : PCF8523_HOUR_MODE_AM;
+        converted.hour %= 12;
+        if (converted.hour == 0)
+            converted.hour = 12;
+    }
+
+    mirror->cached = true;
+    mirror->cachedEpoch = epoch;
+    mirror->cachedDatetime = converted;
+    *datetime = converted;
+
+    return true;
+}
+
+bool pcf8523_mirror_read_stats(const pcf8523_Mirror_t *mirror, pcf8523_MirrorStats_t *stats) {
+    if (!mirror || !stats)
+        return false;
+
+    *stats = mirror->stats;
+
+    return true;
+}
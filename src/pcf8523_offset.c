@@ -0,0 +1,46 @@
+#include "pcf8523_private.h"
+#include "sensor/pcf8523.h"
+
+bool pcf8523_set_offset(pcf8523_t *pcf8523, pcf8523_OffsetMode_t mode, int8_t offset) {
+    if (!pcf8523)
+        return false;
+
+    if (offset > 63 || offset < -64)
+        return false;
+
+    // 7 bit two's complement, bit 7 is the mode
+    uint8_t buffer = (uint8_t)offset & 0x7F;
+
+    if (mode == PCF8523_OFFSET_EVERY_MIN)
+        buffer |= PCF8523_OFFSET_MODE_MASK;
+
+    if (!pcf8523_write_register(pcf8523, PCF8523_OFFSET_REG, buffer))
+        return false;
+
+    return true;
+}
+
+bool pcf8523_read_offset(pcf8523_t *pcf8523, pcf8523_OffsetMode_t *mode, int8_t *offset) {
+    if (!pcf8523 || !offset)
+        return false;
+
+    uint8_t buffer;
+
+    if (!pcf8523_read_register(pcf8523, PCF8523_OFFSET_REG, &buffer))
+        return false;
+
+    if (buffer & PCF8523_OFFSET_MODE_MASK) {
+        *mode = PCF8523_OFFSET_EVERY_MIN;
+        buffer &= (uint8_t)(~PCF8523_OFFSET_MODE_MASK);
+    }
+    else {
+        *mode = PCF8523_OFFSET_EVERY_2_HOURS;
+    }
+
+    if (buffer & 0x40)
+        buffer |= 0x80;
+
+    *offset = (int8_t)buffer;
+
+    return true;
+}
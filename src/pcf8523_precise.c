@@ -0,0 +1,114 @@
+#include "sensor/pcf8523_precise.h"
+#include "hardware/sync.h"
+#include "pcf8523_private.h"
+#include "pico/stdlib.h"
+#include "sensor/pcf8523.h"
+
+static void pcf8523_precise_wait_until(uint64_t targetUs) {
+    uint64_t now = time_us_64();
+
+    if (targetUs > now + PCF8523_PRECISE_SPIN_US)
+        sleep_us(targetUs - now - PCF8523_PRECISE_SPIN_US);
+}
+
+static bool pcf8523_precise_measure_edge(pcf8523_t *pcf8523, uint8_t preloaded,
+                                         uint64_t expectedUs, uint64_t *edgeUs,
+                                         uint32_t *uncertaintyUs) {
+    uint8_t seconds;
+    uint64_t prevSampleUs = 0;
+
+    pcf8523_precise_wait_until(expectedUs - PCF8523_PRECISE_EDGE_GUARD_US);
+
+    uint64_t deadline = expectedUs + PCF8523_PRECISE_EDGE_GUARD_US + 1000000ULL;
+    while (time_us_64() < deadline) {
+        // The time registers are latched at the start of the read access
+        uint64_t sampleUs = time_us_64();
+        if (!pcf8523_read_register(pcf8523, PCF8523_SECONDS_REG, &seconds))
+            return false;
+
+        if ((seconds & (uint8_t)(~PCF8523_SECONDS_OS_MASK)) != preloaded) {
+            // Polling started too late to bracket the edge
+            if (prevSampleUs == 0)
+                return false;
+
+            *edgeUs = (prevSampleUs + sampleUs) / 2;
+            *uncertaintyUs = (uint32_t)((sampleUs - prevSampleUs) / 2);
+            return true;
+        }
+
+        prevSampleUs = sampleUs;
+    }
+
+    return false;
+}
+
+// Leaves the clock running (at an arbitrary phase) rather than stopped after a failure
+static bool pcf8523_precise_abort(pcf8523_t *pcf8523) {
+    pcf8523_freeze_time(pcf8523, false);
+    return false;
+}
+
+bool pcf8523_set_datetime_precise(pcf8523_t *pcf8523, pcf8523_Datetime_t *datetime,
+                                  uint64_t boundaryUs, pcf8523_PreciseSet_t *result) {
+    if (!pcf8523 || !datetime)
+        return false;
+
+    // The RTC has to reach datetime + 1 s at boundaryUs + 1 s
+    uint64_t edgeTargetUs = boundaryUs + 1000000ULL;
+    uint64_t releaseTargetUs = edgeTargetUs - PCF8523_STOP_RELEASE_DELAY_US;
+
+    if (!pcf8523_freeze_time(pcf8523, true))
+        return false;
+
+    if (!pcf8523_set_datetime(pcf8523, datetime))
+        return pcf8523_precise_abort(pcf8523);
+
+    uint8_t ctrl1;
+    if (!pcf8523_read_register(pcf8523, PCF8523_CTRL1_REG, &ctrl1))
+        return pcf8523_precise_abort(pcf8523);
+
+    // Rewriting the frozen value measures how long the release write takes on this bus
+    uint64_t start = time_us_64();
+    if (!pcf8523_write_register(pcf8523, PCF8523_CTRL1_REG, ctrl1))
+        return pcf8523_precise_abort(pcf8523);
+    uint64_t writeUs = time_us_64() - start;
+
+    // STOP is latched with the data byte, at the end of the transfer
+    uint64_t releaseStartUs = releaseTargetUs - writeUs;
+    if (time_us_64() + PCF8523_PRECISE_SPIN_US > releaseStartUs)
+        return pcf8523_precise_abort(pcf8523);
+
+    uint8_t release = (uint8_t)(ctrl1 & ~PCF8523_CTRL1_STOP_MASK);
+
+    pcf8523_precise_wait_until(releaseStartUs);
+
+    uint32_t irq = save_and_disable_interrupts();
+    while (time_us_64() < releaseStartUs)
+        tight_loop_contents();
+    bool ok = pcf8523_write_register(pcf8523, PCF8523_CTRL1_REG, release);
+    uint64_t releaseUs = time_us_64();
+    restore_interrupts(irq);
+
+    if (!ok)
+        return pcf8523_precise_abort(pcf8523);
+
+    if (!result)
+        return true;
+
+    result->releaseUs = releaseUs;
+    result->releaseErrorUs = (int32_t)((int64_t)releaseUs - (int64_t)releaseTargetUs);
+
+    // The RTC is set by now, a failed measurement only leaves the residual error unknown
+    uint64_t edgeUs;
+    if (!pcf8523_precise_measure_edge(pcf8523, pcf8523_decimal_to_bcd(datetime->sec),
+                                      releaseUs + PCF8523_STOP_RELEASE_DELAY_US, &edgeUs,
+                                      &result->uncertaintyUs)) {
+        result->errorUs = 0;
+        result->uncertaintyUs = PCF8523_PRECISE_UNKNOWN_US;
+        return true;
+    }
+
+    result->errorUs = (int32_t)((int64_t)edgeUs - (int64_t)edgeTargetUs);
+
+    return true;
+}
@@ -18,7 +18,6 @@
 #ifndef PCF8523_PRIVATE_H
 #define PCF8523_PRIVATE_H
 
-#include "hardware/i2c.h"
 #include "sensor/pcf8523.h"
 
 #define PCF8523_RESET_COMMAND 0x58
@@ -47,6 +46,15 @@
 #define PCF8523_CTRL1_RESET_MASK (1 << 4)     // SR
 #define PCF8523_CTRL1_HOUR_MODE_MASK (1 << 3) // 12_24
 
+// With a fixed hour format the 12h (or 24h) branches fold away at compile time
+#if PCF8523_FIXED_HOUR_FORMAT == 24
+#define PCF8523_FORMAT_24H(pcf8523) ((void)(pcf8523), true)
+#elif PCF8523_FIXED_HOUR_FORMAT == 12
+#define PCF8523_FORMAT_24H(pcf8523) ((void)(pcf8523), false)
+#else
+#define PCF8523_FORMAT_24H(pcf8523) ((pcf8523)->format24h)
+#endif
+
 typedef enum {
     PCF8523_TMR_CTRL_PERM_TMR_A_TMR_SEC_INT_MASK = (1 << 7),
     PCF8523_TMR_CTRL_PERM_TMR_B_INT_MASK = (1 << 6),
@@ -82,23 +90,188 @@ bool pcf8523_read_block(pcf8523_t *pcf8523, uint8_t startReg, uint8_t *data, siz
 bool pcf8523_set_bit(pcf8523_t *pcf8523, uint8_t reg, uint8_t mask, bool value);
 bool pcf8523_read_bit(pcf8523_t *pcf8523, uint8_t reg, uint8_t mask, bool *value);
 
-pcf8523_HourMode_t pcf8523_extract_hour_mode(uint8_t *hourRaw, bool pcf8523Format24h);
+static inline uint8_t pcf8523_decimal_to_bcd(uint8_t decimal) {
+    return (uint8_t)(decimal + 6 * (decimal / 10));
+}
+
+static inline uint8_t pcf8523_bcd_to_decimal(uint8_t bcd) {
+    return (uint8_t)(bcd - 6 * (bcd >> 4));
+}
+
+// Little endian fields of the binary protocols (telemetry, time sync)
+static inline void pcf8523_put_le16(uint8_t *dst, uint16_t value) {
+    dst[0] = (uint8_t)value;
+    dst[1] = (uint8_t)(value >> 8);
+}
+
+static inline void pcf8523_put_le32(uint8_t *dst, uint32_t value) {
+    pcf8523_put_le16(dst, (uint16_t)value);
+    pcf8523_put_le16(&dst[2], (uint16_t)(value >> 16));
+}
+
+static inline void pcf8523_put_le64(uint8_t *dst, uint64_t value) {
+    pcf8523_put_le32(dst, (uint32_t)value);
+    pcf8523_put_le32(&dst[4], (uint32_t)(value >> 32));
+}
+
+static inline uint16_t pcf8523_get_le16(const uint8_t *src) {
+    return (uint16_t)(src[0] | (src[1] << 8));
+}
+
+static inline uint32_t pcf8523_get_le32(const uint8_t *src) {
+    return (uint32_t)pcf8523_get_le16(src) | ((uint32_t)pcf8523_get_le16(&src[2]) << 16);
+}
 
-static inline uint8_t pcf8523_decimal_to_bcd(uint8_t decimal);
-static inline uint8_t pcf8523_bcd_to_decimal(uint8_t bcd);
+static inline uint64_t pcf8523_get_le64(const uint8_t *src) {
+    return (uint64_t)pcf8523_get_le32(src) | ((uint64_t)pcf8523_get_le32(&src[4]) << 32);
+}
 
-bool pcf8523_validate_datetime(pcf8523_Datetime_t *datetime, bool pcf8523Format24h);
-bool pcf8523_validate_alarm(pcf8523_Alarm_t *alarm, bool pcf8523Format24h);
+static inline bool pcf8523_validate_sec(uint8_t sec) {
+    return sec <= 59;
+}
 
-bool pcf8523_validate_time_field(uint8_t reg, uint8_t value, pcf8523_HourMode_t *hourMode,
-                                 bool pcf8523Format24h);
+static inline bool pcf8523_validate_min(uint8_t min) {
+    return min <= 59;
+}
+
+static inline bool pcf8523_validate_day(uint8_t day) {
+    return day >= 1 && day <= 31;
+}
+
+static inline bool pcf8523_validate_weekday(uint8_t weekDay) {
+    return weekDay <= 6;
+}
+
+static inline bool pcf8523_validate_month(uint8_t month) {
+    return month >= 1 && month <= 12;
+}
+
+static inline bool pcf8523_validate_year(uint8_t year) {
+    return year <= 99;
+}
 
-static inline bool pcf8523_validate_sec(uint8_t sec);
-static inline bool pcf8523_validate_min(uint8_t min);
-static inline bool pcf8523_validate_day(uint8_t day);
-static inline bool pcf8523_validate_weekday(uint8_t weekDay);
-static inline bool pcf8523_validate_month(uint8_t month);
-static inline bool pcf8523_validate_year(uint8_t year);
 static inline bool pcf8523_validate_hour(uint8_t hour, pcf8523_HourMode_t hourMode,
-                                         bool pcf8523Format24h);
+                                         bool pcf8523Format24h) {
+    if (hourMode == PCF8523_HOUR_MODE_24H && !pcf8523Format24h)
+        return false;
+
+    if (hourMode == PCF8523_HOUR_MODE_24H) {
+        return hour <= 23;
+    }
+    else {
+        return hour >= 1 && hour <= 12;
+    }
+}
+
+static inline pcf8523_HourMode_t pcf8523_extract_hour_mode(uint8_t *hourRaw,
+                                                           bool pcf8523Format24h) {
+    if (!hourRaw)
+        return 0;
+
+    if (pcf8523Format24h) {
+        return PCF8523_HOUR_MODE_24H;
+    }
+    else {
+        if (*hourRaw & PCF8523_HOUR_PM_MASK) { // It's PM
+            *hourRaw &= (uint8_t)(~PCF8523_HOUR_PM_MASK); // Delete the PM bit
+            return PCF8523_HOUR_MODE_PM;
+        }
+        else {
+            return PCF8523_HOUR_MODE_AM;
+        }
+    }
+}
+
+// SECONDS..YEARS as read from the device, the OS flag is left to the caller
+static inline void pcf8523_decode_datetime(const uint8_t *buffer, bool pcf8523Format24h,
+                                           pcf8523_Datetime_t *datetime) {
+    uint8_t sec = buffer[PCF8523_SEC] & (uint8_t)(~PCF8523_SECONDS_OS_MASK);
+    uint8_t hour = buffer[PCF8523_HOUR];
+
+    datetime->hourMode = pcf8523_extract_hour_mode(&hour, pcf8523Format24h);
+
+    datetime->sec = pcf8523_bcd_to_decimal(sec);
+    datetime->min = pcf8523_bcd_to_decimal(buffer[PCF8523_MIN]);
+    datetime->hour = pcf8523_bcd_to_decimal(hour);
+    datetime->day = pcf8523_bcd_to_decimal(buffer[PCF8523_DAY]);
+    datetime->weekDay = buffer[PCF8523_WEEKDAY];
+    datetime->month = pcf8523_bcd_to_decimal(buffer[PCF8523_MONTH]);
+    datetime->year = pcf8523_bcd_to_decimal(buffer[PCF8523_YEAR]);
+}
+
+#if PCF8523_SKIP_VALIDATION
+// Trusted builds: the callers guarantee in range values
+static inline bool pcf8523_validate_time_field(uint8_t reg, uint8_t value,
+                                               pcf8523_HourMode_t *hourMode,
+                                               bool pcf8523Format24h) {
+    (void)reg;
+    (void)value;
+    (void)hourMode;
+    (void)pcf8523Format24h;
+    return true;
+}
+
+static inline bool pcf8523_validate_datetime(pcf8523_Datetime_t *datetime,
+                                             bool pcf8523Format24h) {
+    (void)pcf8523Format24h;
+    return datetime;
+}
+
+static inline bool pcf8523_validate_alarm(pcf8523_Alarm_t *alarm, bool pcf8523Format24h) {
+    (void)pcf8523Format24h;
+    return alarm;
+}
+#else
+static inline bool pcf8523_validate_time_field(uint8_t reg, uint8_t value,
+                                               pcf8523_HourMode_t *hourMode,
+                                               bool pcf8523Format24h) {
+    switch (reg) {
+        case PCF8523_SECONDS_REG:
+            return pcf8523_validate_sec(value);
+
+        case PCF8523_MINUTES_ALARM_REG:
+        case PCF8523_MINUTES_REG:
+            return pcf8523_validate_min(value);
+
+        case PCF8523_HOURS_ALARM_REG:
+        case PCF8523_HOURS_REG:
+            if (!hourMode)
+                return false;
+            return pcf8523_validate_hour(value, *hourMode, pcf8523Format24h);
+
+        case PCF8523_WEEKDAYS_ALARM_REG:
+        case PCF8523_WEEKDAYS_REG:
+            return pcf8523_validate_weekday(value);
+
+        case PCF8523_MONTHS_REG:
+            return pcf8523_validate_month(value);
+
+        case PCF8523_YEARS_REG:
+            return pcf8523_validate_year(value);
+
+        default:
+            return false;
+    }
+}
+
+static inline bool pcf8523_validate_datetime(pcf8523_Datetime_t *datetime,
+                                             bool pcf8523Format24h) {
+    if (!datetime)
+        return false;
+
+    return pcf8523_validate_sec(datetime->sec) && pcf8523_validate_min(datetime->min) &&
+           pcf8523_validate_hour(datetime->hour, datetime->hourMode, pcf8523Format24h) &&
+           pcf8523_validate_day(datetime->day) && pcf8523_validate_weekday(datetime->weekDay) &&
+           pcf8523_validate_month(datetime->month) && pcf8523_validate_year(datetime->year);
+}
+
+static inline bool pcf8523_validate_alarm(pcf8523_Alarm_t *alarm, bool pcf8523Format24h) {
+    if (!alarm)
+        return false;
+
+    return pcf8523_validate_min(alarm->minAlarm) &&
+           pcf8523_validate_hour(alarm->hourAlarm, alarm->hourMode, pcf8523Format24h) &&
+           pcf8523_validate_day(alarm->dayAlarm) && pcf8523_validate_weekday(alarm->weekDayAlarm);
+}
+#endif
 #endif
@@ -0,0 +1,240 @@
+#include "sensor/pcf8523_rtos.h"
+#include "pcf8523_private.h"
+#include "sensor/pcf8523.h"
+
+#define PCF8523_CTRL3_FLAG_MASK 0b00001100 // BSF, BLF
+#define PCF8523_CTRL3_BSF_MASK (1 << 3)
+
+// Called with the mutex held, outside of exclusive sections
+static void pcf8523_rtos_begin(pcf8523_Rtos_t *rtos) {
+    // A completion that arrived after an earlier timeout must not end this transfer
+    xTaskNotifyStateClearIndexed(NULL, PCF8523_RTOS_NOTIFY_INDEX);
+    ulTaskNotifyValueClearIndexed(NULL, PCF8523_RTOS_NOTIFY_INDEX, UINT32_MAX);
+
+    rtos->ok = false;
+    rtos->waiter = xTaskGetCurrentTaskHandle();
+}
+
+static bool pcf8523_rtos_end(pcf8523_Rtos_t *rtos, bool started) {
+    bool ok = false;
+
+    if (started) {
+        if (ulTaskNotifyTakeIndexed(PCF8523_RTOS_NOTIFY_INDEX, pdTRUE, rtos->timeout) > 0) {
+            ok = rtos->ok;
+        }
+        else {
+            rtos->timeouts++;
+            if (rtos->bus->abort)
+                rtos->bus->abort(rtos->busCtx);
+        }
+    }
+
+    rtos->waiter = NULL;
+    xSemaphoreGiveRecursive(rtos->mutex);
+
+    return ok;
+}
+
+static bool pcf8523_rtos_read(void *ctx, uint8_t i2cAddress, uint8_t startReg, uint8_t *data,
+                              size_t len) {
+    pcf8523_Rtos_t *rtos = (pcf8523_Rtos_t *)ctx;
+
+    if (xSemaphoreTakeRecursive(rtos->mutex, rtos->timeout) != pdTRUE)
+        return false;
+
+    // While a section runs only its owner can get here, the mutex is held all along
+    if (rtos->exclusiveDepth > 0) {
+        bool ok = rtos->bus->read_polled(rtos->busCtx, i2cAddress, startReg, data, len);
+        xSemaphoreGiveRecursive(rtos->mutex);
+        return ok;
+    }
+
+    pcf8523_rtos_begin(rtos);
+    bool started = rtos->bus->start_read(rtos->busCtx, i2cAddress, startReg, data, len);
+
+    return pcf8523_rtos_end(rtos, started);
+}
+
+static bool pcf8523_rtos_write(void *ctx, uint8_t i2cAddress, const uint8_t *frame,
+                               size_t frameLen) {
+    pcf8523_Rtos_t *rtos = (pcf8523_Rtos_t *)ctx;
+
+    if (xSemaphoreTakeRecursive(rtos->mutex, rtos->timeout) != pdTRUE)
+        return false;
+
+    if (rtos->exclusiveDepth > 0) {
+        bool ok = rtos->bus->write_polled(rtos->busCtx, i2cAddress, frame, frameLen);
+        xSemaphoreGiveRecursive(rtos->mutex);
+        return ok;
+    }
+
+    pcf8523_rtos_begin(rtos);
+    bool started = rtos->bus->start_write(rtos->busCtx, i2cAddress, frame, frameLen);
+
+    return pcf8523_rtos_end(rtos, started);
+}
+
+static const pcf8523_Transport_t pcf8523_rtos_transport = {
+    .read = pcf8523_rtos_read,
+    .write = pcf8523_rtos_write,
+};
+
+bool pcf8523_rtos_init(pcf8523_Rtos_t *rtos, pcf8523_t *pcf8523, const pcf8523_RtosBus_t *bus,
+                       void *busCtx, TickType_t timeout) {
+    if (!rtos || !pcf8523 || !bus || !bus->start_read || !bus->start_write)
+        return false;
+
+    rtos->pcf8523 = pcf8523;
+    rtos->bus = bus;
+    rtos->busCtx = busCtx;
+    rtos->timeout = timeout;
+    rtos->waiter = NULL;
+    rtos->ok = false;
+    rtos->exclusiveDepth = 0;
+    rtos->intTask = NULL;
+    rtos->timeouts = 0;
+    rtos->droppedEvents = 0;
+
+    rtos->mutex = xSemaphoreCreateRecursiveMutexStatic(&rtos->mutexBuffer);
+    rtos->events = xQueueCreateStatic(PCF8523_RTOS_EVENT_QUEUE_LEN, sizeof(pcf8523_RtosEvent_t),
+                                      rtos->eventsStorage, &rtos->eventsBuffer);
+    if (!rtos->mutex || !rtos->events)
+        return false;
+
+    pcf8523->transport = &pcf8523_rtos_transport;
+    pcf8523->transportCtx = rtos;
+
+    return true;
+}
+
+bool pcf8523_rtos_lock(pcf8523_Rtos_t *rtos, TickType_t timeout) {
+    if (!rtos)
+        return false;
+
+    return xSemaphoreTakeRecursive(rtos->mutex, timeout) == pdTRUE;
+}
+
+void pcf8523_rtos_unlock(pcf8523_Rtos_t *rtos) {
+    if (!rtos)
+        return;
+
+    xSemaphoreGiveRecursive(rtos->mutex);
+}
+
+bool pcf8523_rtos_exclusive_begin(pcf8523_Rtos_t *rtos, TickType_t timeout) {
+    if (!rtos || !rtos->bus->read_polled || !rtos->bus->write_polled)
+        return false;
+
+    if (!pcf8523_rtos_lock(rtos, timeout))
+        return false;
+
+    rtos->exclusiveDepth++;
+
+    return true;
+}
+
+void pcf8523_rtos_exclusive_end(pcf8523_Rtos_t *rtos) {
+    if (!rtos || rtos->exclusiveDepth == 0)
+        return;
+
+    rtos->exclusiveDepth--;
+    pcf8523_rtos_unlock(rtos);
+}
+
+void pcf8523_rtos_transfer_done_from_isr(pcf8523_Rtos_t *rtos, bool ok,
+                                         BaseType_t *higherPriorityTaskWoken) {
+    TaskHandle_t waiter = rtos->waiter;
+
+    rtos->ok = ok;
+    if (waiter)
+        vTaskNotifyGiveIndexedFromISR(waiter, PCF8523_RTOS_NOTIFY_INDEX, higherPriorityTaskWoken);
+}
+
+void pcf8523_rtos_transfer_done(pcf8523_Rtos_t *rtos, bool ok) {
+    TaskHandle_t waiter = rtos->waiter;
+
+    rtos->ok = ok;
+    if (waiter)
+        xTaskNotifyGiveIndexed(waiter, PCF8523_RTOS_NOTIFY_INDEX);
+}
+
+// Reads the flags in one burst and clears the pending ones with one write
+static bool pcf8523_rtos_collect(pcf8523_Rtos_t *rtos, pcf8523_RtosEvent_t *event) {
+    uint8_t ctrl[3];
+    if (!pcf8523_read_block(rtos->pcf8523, PCF8523_CTRL1_REG, ctrl, 3))
+        return false;
+
+    event->ctrl2Flags = ctrl[PCF8523_CTRL2_REG] & PCF8523_CTRL2_FLAG_MASK;
+    event->ctrl3Flags = ctrl[PCF8523_CTRL3_REG] & PCF8523_CTRL3_FLAG_MASK;
+    event->tick = xTaskGetTickCount();
+
+    uint8_t clear = event->ctrl3Flags & PCF8523_CTRL3_BSF_MASK;
+    if ((event->ctrl2Flags | clear) == 0)
+        return true;
+
+    // Writing 0 clears a flag, the ones that were not pending are written as 1
+    uint8_t frame[PCF8523_FRAME_SIZE(2)];
+    pcf8523_Transaction_t tx;
+    if (!pcf8523_transaction_init(&tx, PCF8523_CTRL2_REG, frame, 2, true))
+        return false;
+
+    uint8_t *data = pcf8523_transaction_data(&tx);
+    data[0] = (uint8_t)(ctrl[PCF8523_CTRL2_REG] | PCF8523_CTRL2_FLAG_MASK);
+    data[0] &= (uint8_t)(~event->ctrl2Flags);
+    data[1] = (uint8_t)(ctrl[PCF8523_CTRL3_REG] | PCF8523_CTRL3_BSF_MASK);
+    data[1] &= (uint8_t)(~clear);
+
+    return pcf8523_execute(rtos->pcf8523, &tx);
+}
+
+static void pcf8523_rtos_int_task(void *param) {
+    pcf8523_Rtos_t *rtos = (pcf8523_Rtos_t *)param;
+    pcf8523_RtosEvent_t event;
+
+    for (;;) {
+        ulTaskNotifyTakeIndexed(PCF8523_RTOS_INT_NOTIFY_INDEX, pdTRUE, portMAX_DELAY);
+
+        if (!pcf8523_rtos_lock(rtos, portMAX_DELAY))
+            continue;
+        bool ok = pcf8523_rtos_collect(rtos, &event);
+        pcf8523_rtos_unlock(rtos);
+
+        if (!ok || (event.ctrl2Flags | event.ctrl3Flags) == 0)
+            continue;
+
+        if (xQueueSendToBack(rtos->events, &event, 0) != pdTRUE)
+            rtos->droppedEvents++;
+    }
+}
+
+bool pcf8523_rtos_start_int_task(pcf8523_Rtos_t *rtos, UBaseType_t priority,
+                                 configSTACK_DEPTH_TYPE stackDepth) {
+    if (!rtos || rtos->intTask)
+        return false;
+
+    return xTaskCreate(pcf8523_rtos_int_task, "pcf8523_int", stackDepth, rtos, priority,
+                       &rtos->intTask) == pdPASS;
+}
+
+void pcf8523_rtos_signal_int_from_isr(pcf8523_Rtos_t *rtos, BaseType_t *higherPriorityTaskWoken) {
+    if (!rtos || !rtos->intTask)
+        return;
+
+    vTaskNotifyGiveIndexedFromISR(rtos->intTask, PCF8523_RTOS_INT_NOTIFY_INDEX,
+                                  higherPriorityTaskWoken);
+}
+
+void pcf8523_rtos_signal_int(pcf8523_Rtos_t *rtos) {
+    if (!rtos || !rtos->intTask)
+        return;
+
+    xTaskNotifyGiveIndexed(rtos->intTask, PCF8523_RTOS_INT_NOTIFY_INDEX);
+}
+
+bool pcf8523_rtos_wait_event(pcf8523_Rtos_t *rtos, pcf8523_RtosEvent_t *event,
+                             TickType_t timeout) {
+    if (!rtos || !event)
+        return false;
+
+    return xQueueReceive(rtos->events, event, timeout) == pdTRUE;
+}
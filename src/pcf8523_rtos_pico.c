@@ -0,0 +1,197 @@
+#include "sensor/pcf8523_rtos_pico.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "pico/stdlib.h"
+#include "sensor/pcf8523_rtos.h"
+
+static pcf8523_RtosPicoBus_t *pcf8523RtosPicoBuses[2];
+
+static void pcf8523_rtos_pico_stop(pcf8523_RtosPicoBus_t *bus) {
+    i2c_hw_t *hw = i2c_get_hw(bus->i2c);
+
+    hw->intr_mask = 0;
+    hw->dma_cr = 0;
+    bus->active = false;
+}
+
+static void pcf8523_rtos_pico_irq(pcf8523_RtosPicoBus_t *bus) {
+    i2c_hw_t *hw = i2c_get_hw(bus->i2c);
+    uint32_t status = hw->intr_stat;
+    BaseType_t woken = pdFALSE;
+
+    if (status & I2C_IC_INTR_STAT_R_TX_ABRT_BITS) {
+        (void)hw->clr_tx_abrt;
+        dma_channel_abort(bus->txChannel);
+        dma_channel_abort(bus->rxChannel);
+        bus->failed = true;
+    }
+
+    if (status & I2C_IC_INTR_STAT_R_STOP_DET_BITS) {
+        (void)hw->clr_stop_det;
+
+        if (bus->active) {
+            // The last byte may still be on its way from the RX FIFO
+            while (bus->reading && !bus->failed && dma_channel_is_busy(bus->rxChannel))
+                tight_loop_contents();
+
+            pcf8523_rtos_pico_stop(bus);
+            pcf8523_rtos_transfer_done_from_isr(bus->rtos, !bus->failed, &woken);
+        }
+    }
+
+    portYIELD_FROM_ISR(woken);
+}
+
+static void pcf8523_rtos_pico_irq0(void) {
+    pcf8523_rtos_pico_irq(pcf8523RtosPicoBuses[0]);
+}
+
+static void pcf8523_rtos_pico_irq1(void) {
+    pcf8523_rtos_pico_irq(pcf8523RtosPicoBuses[1]);
+}
+
+static void pcf8523_rtos_pico_begin(pcf8523_RtosPicoBus_t *bus, uint8_t i2cAddress, bool reading) {
+    i2c_hw_t *hw = i2c_get_hw(bus->i2c);
+
+    bus->active = true;
+    bus->reading = reading;
+    bus->failed = false;
+
+    hw->enable = 0;
+    hw->tar = i2cAddress;
+    hw->enable = 1;
+
+    (void)hw->clr_intr;
+    hw->dma_tdlr = 4;
+    hw->dma_rdlr = 0;
+    hw->dma_cr = I2C_IC_DMA_CR_TDMAE_BITS | (reading ? I2C_IC_DMA_CR_RDMAE_BITS : 0);
+    hw->intr_mask = I2C_IC_INTR_MASK_M_STOP_DET_BITS | I2C_IC_INTR_MASK_M_TX_ABRT_BITS;
+}
+
+static void pcf8523_rtos_pico_start_tx(pcf8523_RtosPicoBus_t *bus, size_t count) {
+    i2c_hw_t *hw = i2c_get_hw(bus->i2c);
+    dma_channel_config config = dma_channel_get_default_config(bus->txChannel);
+
+    channel_config_set_transfer_data_size(&config, DMA_SIZE_32);
+    channel_config_set_read_increment(&config, true);
+    channel_config_set_write_increment(&config, false);
+    channel_config_set_dreq(&config, i2c_get_dreq(bus->i2c, true));
+
+    dma_channel_configure(bus->txChannel, &config, &hw->data_cmd, bus->cmd, (uint)count, true);
+}
+
+static bool pcf8523_rtos_pico_start_read(void *ctx, uint8_t i2cAddress, uint8_t startReg,
+                                         uint8_t *data, size_t len) {
+    pcf8523_RtosPicoBus_t *bus = (pcf8523_RtosPicoBus_t *)ctx;
+
+    if (len == 0 || len > PCF8523_REGISTER_COUNT)
+        return false;
+
+    // Register address, then one read command per byte after a repeated start
+    bus->cmd[0] = startReg;
+    for (size_t i = 0; i < len; i++)
+        bus->cmd[1 + i] = I2C_IC_DATA_CMD_CMD_BITS;
+    bus->cmd[1] |= I2C_IC_DATA_CMD_RESTART_BITS;
+    bus->cmd[len] |= I2C_IC_DATA_CMD_STOP_BITS;
+
+    pcf8523_rtos_pico_begin(bus, i2cAddress, true);
+
+    i2c_hw_t *hw = i2c_get_hw(bus->i2c);
+    dma_channel_config config = dma_channel_get_default_config(bus->rxChannel);
+
+    channel_config_set_transfer_data_size(&config, DMA_SIZE_8);
+    channel_config_set_read_increment(&config, false);
+    channel_config_set_write_increment(&config, true);
+    channel_config_set_dreq(&config, i2c_get_dreq(bus->i2c, false));
+
+    dma_channel_configure(bus->rxChannel, &config, data, &hw->data_cmd, (uint)len, true);
+    pcf8523_rtos_pico_start_tx(bus, len + 1);
+
+    return true;
+}
+
+static bool pcf8523_rtos_pico_start_write(void *ctx, uint8_t i2cAddress, const uint8_t *frame,
+                                          size_t frameLen) {
+    pcf8523_RtosPicoBus_t *bus = (pcf8523_RtosPicoBus_t *)ctx;
+
+    if (frameLen == 0 || frameLen > PCF8523_FRAME_SIZE(PCF8523_REGISTER_COUNT))
+        return false;
+
+    for (size_t i = 0; i < frameLen; i++)
+        bus->cmd[i] = frame[i];
+    bus->cmd[frameLen - 1] |= I2C_IC_DATA_CMD_STOP_BITS;
+
+    pcf8523_rtos_pico_begin(bus, i2cAddress, false);
+    pcf8523_rtos_pico_start_tx(bus, frameLen);
+
+    return true;
+}
+
+static void pcf8523_rtos_pico_abort(void *ctx) {
+    pcf8523_RtosPicoBus_t *bus = (pcf8523_RtosPicoBus_t *)ctx;
+
+    dma_channel_abort(bus->txChannel);
+    dma_channel_abort(bus->rxChannel);
+    pcf8523_rtos_pico_stop(bus);
+
+    // Disabling the controller flushes both FIFOs
+    i2c_get_hw(bus->i2c)->enable = 0;
+}
+
+static bool pcf8523_rtos_pico_read_polled(void *ctx, uint8_t i2cAddress, uint8_t startReg,
+                                          uint8_t *data, size_t len) {
+    pcf8523_RtosPicoBus_t *bus = (pcf8523_RtosPicoBus_t *)ctx;
+
+    return pcf8523_pico_transport.read(bus->i2c, i2cAddress, startReg, data, len);
+}
+
+static bool pcf8523_rtos_pico_write_polled(void *ctx, uint8_t i2cAddress, const uint8_t *frame,
+                                           size_t frameLen) {
+    pcf8523_RtosPicoBus_t *bus = (pcf8523_RtosPicoBus_t *)ctx;
+
+    return pcf8523_pico_transport.write(bus->i2c, i2cAddress, frame, frameLen);
+}
+
+const pcf8523_RtosBus_t pcf8523_rtos_pico_bus = {
+    .start_read = pcf8523_rtos_pico_start_read,
+    .start_write = pcf8523_rtos_pico_start_write,
+    .abort = pcf8523_rtos_pico_abort,
+    .read_polled = pcf8523_rtos_pico_read_polled,
+    .write_polled = pcf8523_rtos_pico_write_polled,
+};
+
+bool pcf8523_rtos_pico_bus_init(pcf8523_RtosPicoBus_t *bus, i2c_inst_t *i2c,
+                                pcf8523_Rtos_t *rtos) {
+    if (!bus || !i2c || !rtos)
+        return false;
+
+    uint index = i2c_hw_index(i2c);
+    if (pcf8523RtosPicoBuses[index])
+        return false;
+
+    int txChannel = dma_claim_unused_channel(false);
+    int rxChannel = dma_claim_unused_channel(false);
+    if (txChannel < 0 || rxChannel < 0) {
+        if (txChannel >= 0)
+            dma_channel_unclaim((uint)txChannel);
+        if (rxChannel >= 0)
+            dma_channel_unclaim((uint)rxChannel);
+        return false;
+    }
+
+    bus->i2c = i2c;
+    bus->rtos = rtos;
+    bus->txChannel = (uint)txChannel;
+    bus->rxChannel = (uint)rxChannel;
+    bus->active = false;
+    bus->reading = false;
+    bus->failed = false;
+
+    pcf8523RtosPicoBuses[index] = bus;
+
+    uint irq = I2C0_IRQ + index;
+    irq_set_exclusive_handler(irq, index == 0 ? pcf8523_rtos_pico_irq0 : pcf8523_rtos_pico_irq1);
+    irq_set_enabled(irq, true);
+
+    return true;
+}
@@ -0,0 +1,279 @@
+#include "sensor/pcf8523_sleep.h"
+#include "pcf8523_private.h"
+#include "pico/stdlib.h"
+#include "sensor/pcf8523.h"
+
+typedef struct {
+    pcf8523_t *pcf8523;
+    uint16_t century;
+    uint64_t deadline;
+
+    uint64_t edgeUs; // time_us_64() estimate of the RTC edge into edgeEpoch
+    uint64_t edgeEpoch;
+    uint32_t uncertaintyUs;
+
+    pcf8523_SleepResult_t result;
+} pcf8523_SleepCtx_t;
+
+static void pcf8523_sleep_to(pcf8523_SleepCtx_t *ctx, uint64_t targetUs) {
+    uint64_t now = time_us_64();
+
+    if (targetUs > now) {
+        sleep_us(targetUs - now);
+        ctx->result.wakeups++;
+    }
+}
+
+// The time registers are latched at the start of the read, atUs is taken just before it. CTRL1
+// comes along in the same transfer, a frozen clock would never reach the deadline
+static bool pcf8523_sleep_read_seconds(pcf8523_SleepCtx_t *ctx, uint8_t *seconds, uint64_t *atUs) {
+    uint8_t buffer[PCF8523_SECONDS_REG - PCF8523_CTRL1_REG + 1];
+
+    *atUs = time_us_64();
+    if (!pcf8523_read_block(ctx->pcf8523, PCF8523_CTRL1_REG, buffer, sizeof(buffer)))
+        return false;
+    ctx->result.reads++;
+
+    uint8_t raw = buffer[PCF8523_SECONDS_REG - PCF8523_CTRL1_REG];
+    if ((buffer[0] & PCF8523_CTRL1_STOP_MASK) || (raw & PCF8523_SECONDS_OS_MASK))
+        return false;
+
+    *seconds = pcf8523_bcd_to_decimal(raw);
+
+    return true;
+}
+
+static bool pcf8523_sleep_read_epoch(pcf8523_SleepCtx_t *ctx, uint64_t *epoch, uint64_t *atUs) {
+    pcf8523_Datetime_t datetime;
+    uint16_t health;
+
+    *atUs = time_us_64();
+    if (!pcf8523_read_datetime_health(ctx->pcf8523, &datetime, &health))
+        return false;
+    ctx->result.reads++;
+
+    if (health & (PCF8523_HEALTH_OS | PCF8523_HEALTH_STOP))
+        return false;
+
+    *epoch = pcf8523_datetime_to_epoch(&datetime, ctx->century);
+
+    return true;
+}
+
+static inline uint64_t pcf8523_sleep_drift(uint64_t spanUs) {
+    return (spanUs * PCF8523_SLEEP_DRIFT_PPM) / 1000000ULL;
+}
+
+// Moves the edge estimate seconds edges ahead, the drift widens it on the way
+static void pcf8523_sleep_project(pcf8523_SleepCtx_t *ctx, uint64_t seconds) {
+    uint64_t spanUs = seconds * 1000000ULL;
+
+    ctx->edgeEpoch += seconds;
+    ctx->edgeUs += spanUs;
+    ctx->uncertaintyUs += (uint32_t)pcf8523_sleep_drift(spanUs);
+}
+
+/*
+ * Bisects the phase of the RTC second. Time only runs forward, so every probe samples the midpoint
+ * of the bracket on the first edge that is still ahead, which makes the search ride on the wait
+ * itself. It stops early if the next probe would land on the deadline edge.
+ */
+static bool pcf8523_sleep_refine(pcf8523_SleepCtx_t *ctx) {
+    while (ctx->uncertaintyUs > PCF8523_SLEEP_PHASE_US) {
+        uint64_t now = time_us_64();
+        uint64_t seconds = now >= ctx->edgeUs ? (now - ctx->edgeUs) / 1000000ULL + 1 : 0;
+
+        if (ctx->edgeEpoch + seconds >= ctx->deadline)
+            break;
+
+        pcf8523_sleep_project(ctx, seconds);
+
+        uint64_t lo = ctx->edgeUs - ctx->uncertaintyUs;
+        uint64_t hi = ctx->edgeUs + ctx->uncertaintyUs;
+        uint8_t before = (uint8_t)((ctx->edgeEpoch - 1) % 60);
+        uint8_t raw;
+        uint64_t atUs;
+
+        pcf8523_sleep_to(ctx, ctx->edgeUs);
+        if (!pcf8523_sleep_read_seconds(ctx, &raw, &atUs))
+            return false;
+
+        if (raw != before) {
+            if (atUs < hi)
+                hi = atUs;
+        }
+        else if (atUs < hi) {
+            lo = atUs;
+        }
+        else {
+            // Still before an edge expected earlier, the drift was larger than assumed
+            lo = atUs;
+            hi = atUs + 2 * ctx->uncertaintyUs;
+        }
+
+        ctx->edgeUs = lo + (hi - lo) / 2;
+        ctx->uncertaintyUs = (uint32_t)((hi - lo + 1) / 2);
+    }
+
+    return true;
+}
+
+typedef enum {
+    PCF8523_SLEEP_WAITING = 0,
+    PCF8523_SLEEP_EDGE,   // The register just turned to the deadline second
+    PCF8523_SLEEP_JUMPED, // The RTC was set past the deadline, ctx holds a coarse edge
+    PCF8523_SLEEP_FAILED
+} pcf8523_SleepState_t;
+
+/*
+ * Near the deadline the register shows one or two seconds before it, or the deadline itself.
+ * Anything else means the RTC was set while waiting, and the full time decides: a jump past the
+ * deadline ends the wait with the edge known to a second, a jump back fails.
+ */
+static pcf8523_SleepState_t pcf8523_sleep_classify(pcf8523_SleepCtx_t *ctx, uint8_t seconds) {
+    uint8_t past = (uint8_t)((seconds + 60 - ctx->deadline % 60) % 60);
+
+    if (past == 0)
+        return PCF8523_SLEEP_EDGE;
+    if (past >= 58)
+        return PCF8523_SLEEP_WAITING;
+
+    uint64_t epoch;
+    uint64_t atUs;
+    if (!pcf8523_sleep_read_epoch(ctx, &epoch, &atUs) || epoch < ctx->deadline)
+        return PCF8523_SLEEP_FAILED;
+
+    ctx->edgeUs = atUs - (epoch - ctx->deadline) * 1000000ULL;
+    ctx->uncertaintyUs = 1000000;
+
+    return PCF8523_SLEEP_JUMPED;
+}
+
+// Polls the seconds register until it shows the deadline, sleeping while outside the band
+static bool pcf8523_sleep_catch(pcf8523_SleepCtx_t *ctx, uint64_t bandStart, uint64_t bandEnd) {
+    bool wide = bandEnd - bandStart > 2 * PCF8523_SLEEP_MAX_GUARD_US;
+    uint64_t timeoutUs = bandEnd + 1000000ULL;
+    uint8_t seconds;
+    uint64_t prev;
+
+    if (!pcf8523_sleep_read_seconds(ctx, &seconds, &prev))
+        return false;
+
+    switch (pcf8523_sleep_classify(ctx, seconds)) {
+        case PCF8523_SLEEP_EDGE: {
+            // Woken up after the edge, it happened somewhere between the band start and this read
+            uint64_t earliest = bandStart < prev ? bandStart : prev;
+            ctx->edgeUs = earliest + (prev - earliest) / 2;
+            ctx->uncertaintyUs = (uint32_t)((prev - earliest + 1) / 2);
+            return true;
+        }
+        case PCF8523_SLEEP_JUMPED:
+            return true;
+        case PCF8523_SLEEP_FAILED:
+            return false;
+        default:
+            break;
+    }
+
+    // A clock that stopped counting without raising OS or STOP runs into the timeout
+    while (prev < timeoutUs) {
+        if (wide || prev >= bandEnd) {
+            sleep_us(PCF8523_SLEEP_COARSE_POLL_US);
+            ctx->result.wakeups++;
+        }
+
+        uint64_t now;
+        if (!pcf8523_sleep_read_seconds(ctx, &seconds, &now))
+            return false;
+
+        switch (pcf8523_sleep_classify(ctx, seconds)) {
+            case PCF8523_SLEEP_EDGE:
+                ctx->edgeUs = prev + (now - prev) / 2;
+                ctx->uncertaintyUs = (uint32_t)((now - prev + 1) / 2);
+                return true;
+            case PCF8523_SLEEP_JUMPED:
+                return true;
+            case PCF8523_SLEEP_FAILED:
+                return false;
+            default:
+                break;
+        }
+
+        prev = now;
+    }
+
+    return false;
+}
+
+bool pcf8523_sleep_until_epoch(pcf8523_t *pcf8523, uint64_t deadline, uint16_t century,
+                               pcf8523_SleepResult_t *result) {
+    if (!pcf8523)
+        return false;
+
+    pcf8523_SleepCtx_t ctx = {
+        .pcf8523 = pcf8523,
+        .century = century,
+        .deadline = deadline,
+    };
+
+    uint64_t epoch;
+    uint64_t readUs;
+
+    if (!pcf8523_sleep_read_epoch(&ctx, &epoch, &readUs))
+        return false;
+
+    if (epoch >= deadline) {
+        // Already there, only the whole seconds are known
+        ctx.result.latenessUs = (int64_t)((epoch - deadline) * 1000000ULL);
+        ctx.result.uncertaintyUs = 1000000;
+    }
+    else {
+        // The next edge lies within one (slightly drifted) second after the read
+        uint32_t halfUs = (uint32_t)((1000000ULL + pcf8523_sleep_drift(1000000ULL)) / 2);
+        ctx.edgeEpoch = epoch + 1;
+        ctx.edgeUs = readUs + halfUs;
+        ctx.uncertaintyUs = halfUs;
+
+        if (!pcf8523_sleep_refine(&ctx))
+            return false;
+
+        uint64_t spanUs = (deadline - ctx.edgeEpoch) * 1000000ULL;
+        uint64_t guard = ctx.uncertaintyUs + pcf8523_sleep_drift(spanUs) + PCF8523_SLEEP_GUARD_US;
+
+        // Too much drift accumulates over the wait, the phase is refined again near the end
+        if (guard > PCF8523_SLEEP_MAX_GUARD_US && spanUs > PCF8523_SLEEP_RESYNC_LEAD_US + guard) {
+            pcf8523_sleep_to(&ctx, ctx.edgeUs + spanUs - PCF8523_SLEEP_RESYNC_LEAD_US - guard);
+            pcf8523_sleep_project(&ctx, (time_us_64() - ctx.edgeUs) / 1000000ULL);
+
+            if (!pcf8523_sleep_refine(&ctx))
+                return false;
+
+            spanUs = (deadline - ctx.edgeEpoch) * 1000000ULL;
+            guard = ctx.uncertaintyUs + pcf8523_sleep_drift(spanUs) + PCF8523_SLEEP_GUARD_US;
+        }
+
+        uint64_t predicted = ctx.edgeUs + spanUs;
+        uint64_t bandStart = predicted > guard ? predicted - guard : 0;
+
+        pcf8523_sleep_to(&ctx, bandStart);
+        if (!pcf8523_sleep_catch(&ctx, bandStart, predicted + guard))
+            return false;
+
+        ctx.result.latenessUs = (int64_t)(time_us_64() - ctx.edgeUs);
+        ctx.result.uncertaintyUs = ctx.uncertaintyUs;
+    }
+
+    if (result)
+        *result = ctx.result;
+
+    return true;
+}
+
+bool pcf8523_sleep_until(pcf8523_t *pcf8523, const pcf8523_Datetime_t *deadline, uint16_t century,
+                         pcf8523_SleepResult_t *result) {
+    if (!pcf8523 || !deadline)
+        return false;
+
+    return pcf8523_sleep_until_epoch(pcf8523, pcf8523_datetime_to_epoch(deadline, century), century,
+                                     result);
+}
@@ -0,0 +1,174 @@
+#include "sensor/pcf8523_sync.h"
+#include "pcf8523_private.h"
+#include "sensor/pcf8523.h"
+
+#include <string.h>
+
+#define PCF8523_SYNC_MESSAGE_SIZE 25 // round u8 and three u64, the request is padded to it
+#define PCF8523_SYNC_REPORT_SIZE 29
+
+bool pcf8523_sync_init(pcf8523_Sync_t *sync) {
+    if (!sync)
+        return false;
+
+    memset(sync, 0, sizeof(*sync));
+
+    return true;
+}
+
+bool pcf8523_sync_request(pcf8523_Sync_t *sync, pcf8523_TelemetryEncoder_t *enc, uint64_t nowUs) {
+    if (!sync || !enc)
+        return false;
+
+    uint8_t body[PCF8523_SYNC_MESSAGE_SIZE] = {0};
+
+    sync->round++;
+    sync->requestUs = nowUs;
+    sync->pending = true;
+
+    body[0] = sync->round;
+    pcf8523_put_le64(&body[1], nowUs);
+
+    if (!pcf8523_telemetry_add(enc, PCF8523_TELEMETRY_SYNC_REQUEST, body, sizeof(body)))
+        return false;
+
+    return pcf8523_telemetry_flush(enc);
+}
+
+bool pcf8523_sync_handle(pcf8523_Sync_t *sync, const pcf8523_TelemetryRecord_t *record,
+                         uint64_t receiveUs) {
+    if (!sync || !record || !sync->pending)
+        return false;
+
+    if (record->type != PCF8523_TELEMETRY_SYNC_RESPONSE || record->len != PCF8523_SYNC_MESSAGE_SIZE)
+        return false;
+
+    // Late answers to earlier rounds carry a stale t1 and are ignored
+    if (record->body[0] != sync->round || pcf8523_get_le64(&record->body[1]) != sync->requestUs)
+        return false;
+
+    sync->pending = false;
+
+    return pcf8523_sync_add_round(sync, sync->requestUs, pcf8523_get_le64(&record->body[9]),
+                                  pcf8523_get_le64(&record->body[17]), receiveUs);
+}
+
+bool pcf8523_sync_add_round(pcf8523_Sync_t *sync, uint64_t t1, uint64_t t2, uint64_t t3,
+                            uint64_t t4) {
+    if (!sync || t4 < t1 || t3 < t2)
+        return false;
+
+    uint64_t deviceUs = t4 - t1;
+    uint64_t hostUs = t3 - t2;
+
+    // The host cannot spend longer on the answer than the device waited for it
+    if (hostUs > deviceUs || deviceUs - hostUs > UINT32_MAX)
+        return false;
+
+    uint32_t delay = (uint32_t)(deviceUs - hostUs);
+    int64_t offset = ((int64_t)(t2 - t1) + (int64_t)(t3 - t4)) / 2;
+
+    if (sync->rounds < UINT8_MAX)
+        sync->rounds++;
+
+    if (delay > sync->maxDelayUs)
+        sync->maxDelayUs = delay;
+
+    if (!sync->valid || delay <= sync->delayUs) {
+        sync->valid = true;
+        sync->offsetUs = offset;
+        sync->delayUs = delay;
+    }
+
+    return true;
+}
+
+bool pcf8523_sync_next_boundary(const pcf8523_Sync_t *sync, uint64_t nowUs, uint32_t leadUs,
+                                uint64_t *boundaryUs, uint32_t *epoch) {
+    if (!sync || !boundaryUs || !epoch || !sync->valid)
+        return false;
+
+    int64_t hostUs = (int64_t)(nowUs + leadUs) + sync->offsetUs;
+    if (hostUs < 0)
+        return false;
+
+    uint64_t second = ((uint64_t)hostUs + 999999ULL) / 1000000ULL;
+    if (second > UINT32_MAX)
+        return false;
+
+    *epoch = (uint32_t)second;
+    *boundaryUs = (uint64_t)((int64_t)(second * 1000000ULL) - sync->offsetUs);
+
+    return true;
+}
+
+bool pcf8523_sync_parse_request(const pcf8523_TelemetryRecord_t *record, uint8_t *round,
+                                uint64_t *requestUs) {
+    if (!record || !round || !requestUs)
+        return false;
+
+    if (record->type != PCF8523_TELEMETRY_SYNC_REQUEST || record->len != PCF8523_SYNC_MESSAGE_SIZE)
+        return false;
+
+    *round = record->body[0];
+    *requestUs = pcf8523_get_le64(&record->body[1]);
+
+    return true;
+}
+
+bool pcf8523_sync_send_response(pcf8523_TelemetryEncoder_t *enc, uint8_t round,
+                                uint64_t requestUs, uint64_t receiveUs, uint64_t transmitUs) {
+    if (!enc)
+        return false;
+
+    uint8_t body[PCF8523_SYNC_MESSAGE_SIZE];
+
+    body[0] = round;
+    pcf8523_put_le64(&body[1], requestUs);
+    pcf8523_put_le64(&body[9], receiveUs);
+    pcf8523_put_le64(&body[17], transmitUs);
+
+    if (!pcf8523_telemetry_add(enc, PCF8523_TELEMETRY_SYNC_RESPONSE, body, sizeof(body)))
+        return false;
+
+    return pcf8523_telemetry_flush(enc);
+}
+
+bool pcf8523_sync_send_report(pcf8523_TelemetryEncoder_t *enc, const pcf8523_SyncReport_t *report) {
+    if (!enc || !report)
+        return false;
+
+    uint8_t body[PCF8523_SYNC_REPORT_SIZE];
+
+    pcf8523_put_le32(&body[0], report->epoch);
+    pcf8523_put_le64(&body[4], (uint64_t)report->offsetUs);
+    pcf8523_put_le32(&body[12], report->delayUs);
+    pcf8523_put_le32(&body[16], report->maxDelayUs);
+    body[20] = report->rounds;
+    pcf8523_put_le32(&body[21], (uint32_t)report->errorUs);
+    pcf8523_put_le32(&body[25], report->uncertaintyUs);
+
+    if (!pcf8523_telemetry_add(enc, PCF8523_TELEMETRY_SYNC_REPORT, body, sizeof(body)))
+        return false;
+
+    return pcf8523_telemetry_flush(enc);
+}
+
+bool pcf8523_sync_parse_report(const pcf8523_TelemetryRecord_t *record,
+                               pcf8523_SyncReport_t *report) {
+    if (!record || !report)
+        return false;
+
+    if (record->type != PCF8523_TELEMETRY_SYNC_REPORT || record->len != PCF8523_SYNC_REPORT_SIZE)
+        return false;
+
+    report->epoch = pcf8523_get_le32(&record->body[0]);
+    report->offsetUs = (int64_t)pcf8523_get_le64(&record->body[4]);
+    report->delayUs = pcf8523_get_le32(&record->body[12]);
+    report->maxDelayUs = pcf8523_get_le32(&record->body[16]);
+    report->rounds = record->body[20];
+    report->errorUs = (int32_t)pcf8523_get_le32(&record->body[21]);
+    report->uncertaintyUs = pcf8523_get_le32(&record->body[25]);
+
+    return true;
+}
@@ -0,0 +1,85 @@
+#include "sensor/pcf8523_sync.h"
+#include "pcf8523_private.h"
+#include "pico/stdlib.h"
+#include "sensor/pcf8523.h"
+#include "sensor/pcf8523_precise.h"
+
+#define PCF8523_SYNC_RX_CHUNK 64
+
+typedef struct {
+    pcf8523_Sync_t *sync;
+    uint64_t receiveUs;
+} pcf8523_SyncRx_t;
+
+static void pcf8523_sync_on_record(void *ctx, const pcf8523_TelemetryRecord_t *record) {
+    pcf8523_SyncRx_t *rx = (pcf8523_SyncRx_t *)ctx;
+
+    pcf8523_sync_handle(rx->sync, record, rx->receiveUs);
+}
+
+bool pcf8523_sync_run(pcf8523_Sync_t *sync, pcf8523_t *pcf8523, pcf8523_TelemetryEncoder_t *enc,
+                      pcf8523_SyncSource_t source, void *sourceCtx, uint8_t rounds,
+                      pcf8523_SyncReport_t *report) {
+    if (!sync || !pcf8523 || !enc || !source || rounds == 0)
+        return false;
+
+    pcf8523_SyncRx_t rx = {.sync = sync};
+    pcf8523_TelemetryDecoder_t dec;
+    uint8_t chunk[PCF8523_SYNC_RX_CHUNK];
+
+    pcf8523_sync_init(sync);
+    pcf8523_telemetry_decoder_init(&dec, pcf8523_sync_on_record, &rx);
+
+    if (!pcf8523_telemetry_flush(enc))
+        return false;
+
+    for (uint8_t i = 0; i < rounds; i++) {
+        if (!pcf8523_sync_request(sync, enc, time_us_64()))
+            return false;
+
+        // Polled without sleeping, t4 is late by at most one pass through the loop
+        uint64_t deadline = sync->requestUs + PCF8523_SYNC_ROUND_TIMEOUT_US;
+        while (sync->pending && time_us_64() < deadline) {
+            size_t n = source(sourceCtx, chunk, sizeof(chunk));
+            rx.receiveUs = time_us_64();
+            if (n > 0)
+                pcf8523_telemetry_decode(&dec, chunk, n);
+        }
+
+        sync->pending = false;
+    }
+
+    uint64_t boundaryUs;
+    uint32_t epoch;
+    if (!pcf8523_sync_next_boundary(sync, time_us_64(), PCF8523_SYNC_SET_LEAD_US, &boundaryUs,
+                                    &epoch))
+        return false;
+
+    pcf8523_Datetime_t datetime = epoch_to_pcf8523_datetime(epoch);
+
+    if (!PCF8523_FORMAT_24H(pcf8523)) {
+        datetime.hourMode = datetime.hour >= 12 ? PCF8523_HOUR_MODE_PM : PCF8523_HOUR_MODE_AM;
+        datetime.hour %= 12;
+        if (datetime.hour == 0)
+            datetime.hour = 12;
+    }
+
+    pcf8523_PreciseSet_t precise;
+    if (!pcf8523_set_datetime_precise(pcf8523, &datetime, boundaryUs, &precise))
+        return false;
+
+    pcf8523_SyncReport_t sent = {
+        .epoch = epoch,
+        .offsetUs = sync->offsetUs,
+        .delayUs = sync->delayUs,
+        .maxDelayUs = sync->maxDelayUs,
+        .rounds = sync->rounds,
+        .errorUs = precise.errorUs,
+        .uncertaintyUs = precise.uncertaintyUs,
+    };
+
+    if (report)
+        *report = sent;
+
+    return pcf8523_sync_send_report(enc, &sent);
+}
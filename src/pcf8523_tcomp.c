@@ -0,0 +1,198 @@
+#include "sensor/pcf8523_tcomp.h"
+#include "sensor/pcf8523.h"
+
+#define PCF8523_TCOMP_OFFSET_MIN -64
+#define PCF8523_TCOMP_OFFSET_MAX 63
+
+static int32_t pcf8523_tcomp_step_ppb(pcf8523_OffsetMode_t mode) {
+    return mode == PCF8523_OFFSET_EVERY_MIN ? PCF8523_TCOMP_STEP_MIN_PPB
+                                            : PCF8523_TCOMP_STEP_2H_PPB;
+}
+
+static int64_t pcf8523_tcomp_div_round(int64_t value, int64_t divisor) {
+    if ((value < 0) != (divisor < 0))
+        return (value - divisor / 2) / divisor;
+
+    return (value + divisor / 2) / divisor;
+}
+
+void pcf8523_tcomp_default_config(pcf8523_TcompConfig_t *config) {
+    if (!config)
+        return;
+
+    *config = (pcf8523_TcompConfig_t){
+        .mode = PCF8523_OFFSET_EVERY_2_HOURS,
+        .minIntervalMs = 10 * 60 * 1000,
+        .turnoverMilliC = PCF8523_TCOMP_TURNOVER_MC,
+        .parabolicPpb = PCF8523_TCOMP_PARABOLIC_PPB,
+        .staticPpb = 0,
+        .table = NULL,
+        .tableSize = 0,
+    };
+}
+
+bool pcf8523_tcomp_init(pcf8523_Tcomp_t *tc, pcf8523_t *pcf8523,
+                        const pcf8523_TcompConfig_t *config, pcf8523_TcompLog_t log, void *logCtx) {
+    if (!tc || !pcf8523 || !config)
+        return false;
+
+    if (config->table && config->tableSize == 0)
+        return false;
+
+    pcf8523_OffsetMode_t mode;
+    int8_t offset;
+    if (!pcf8523_read_offset(pcf8523, &mode, &offset))
+        return false;
+
+    tc->pcf8523 = pcf8523;
+    tc->config = *config;
+    tc->log = log;
+    tc->logCtx = logCtx;
+    tc->started = false;
+    tc->tempMilliC = 0;
+    tc->deviationPpb = 0;
+    tc->offset = offset;
+    tc->lastUpdateMs = 0;
+    tc->lastWriteMs = 0;
+    tc->correctionNs = 0;
+    tc->correctionRem = 0;
+    tc->writes = 0;
+    tc->deferred = 0;
+
+    // A different mode is fixed by the first update, whatever the correction is
+    tc->synced = mode == config->mode;
+
+    return true;
+}
+
+static int32_t pcf8523_tcomp_table_lookup(const pcf8523_TcompConfig_t *config, int32_t tempMilliC) {
+    const pcf8523_TcompPoint_t *table = config->table;
+    uint8_t last = (uint8_t)(config->tableSize - 1);
+
+    if (tempMilliC <= table[0].tempMilliC)
+        return table[0].deviationPpb;
+    if (tempMilliC >= table[last].tempMilliC)
+        return table[last].deviationPpb;
+
+    uint8_t i = 1;
+    while (table[i].tempMilliC < tempMilliC)
+        i++;
+
+    const pcf8523_TcompPoint_t *lo = &table[i - 1];
+    const pcf8523_TcompPoint_t *hi = &table[i];
+    int64_t span = (int64_t)hi->tempMilliC - lo->tempMilliC;
+    int64_t delta = (int64_t)hi->deviationPpb - lo->deviationPpb;
+
+    return lo->deviationPpb +
+           (int32_t)pcf8523_tcomp_div_round(delta * (tempMilliC - lo->tempMilliC), span);
+}
+
+int32_t pcf8523_tcomp_deviation_ppb(const pcf8523_TcompConfig_t *config, int32_t tempMilliC) {
+    if (!config)
+        return 0;
+
+    if (config->table)
+        return pcf8523_tcomp_table_lookup(config, tempMilliC);
+
+    int64_t delta = (int64_t)tempMilliC - config->turnoverMilliC;
+
+    return config->staticPpb +
+           (int32_t)pcf8523_tcomp_div_round((int64_t)config->parabolicPpb * delta * delta,
+                                            1000000);
+}
+
+bool pcf8523_tcomp_learn(pcf8523_TcompPoint_t *table, uint8_t tableSize, int32_t tempMilliC,
+                         int32_t measuredPpb) {
+    if (!table || tableSize == 0)
+        return false;
+
+    uint8_t closest = 0;
+    int64_t closestDistance = INT64_MAX;
+    for (uint8_t i = 0; i < tableSize; i++) {
+        int64_t distance = (int64_t)table[i].tempMilliC - tempMilliC;
+        if (distance < 0)
+            distance = -distance;
+        if (distance < closestDistance) {
+            closestDistance = distance;
+            closest = i;
+        }
+    }
+
+    table[closest].deviationPpb += (measuredPpb - table[closest].deviationPpb) /
+                                   (1 << PCF8523_TCOMP_LEARN_SHIFT);
+
+    return true;
+}
+
+// Time added by the offset currently in the register since the last update
+static void pcf8523_tcomp_integrate(pcf8523_Tcomp_t *tc, uint32_t elapsedMs) {
+    int64_t ppb = (int64_t)tc->offset * pcf8523_tcomp_step_ppb(tc->config.mode);
+
+    // ppb * ms is in ps
+    tc->correctionRem += ppb * elapsedMs;
+    tc->correctionNs += tc->correctionRem / 1000;
+    tc->correctionRem %= 1000;
+}
+
+bool pcf8523_tcomp_update(pcf8523_Tcomp_t *tc, int32_t tempMilliC, uint32_t nowMs) {
+    if (!tc || !tc->pcf8523)
+        return false;
+
+    if (!tc->started) {
+        tc->started = true;
+        tc->tempMilliC = tempMilliC;
+    }
+    else {
+        if (tc->synced)
+            pcf8523_tcomp_integrate(tc, nowMs - tc->lastUpdateMs);
+        tc->tempMilliC += (tempMilliC - tc->tempMilliC) / (1 << PCF8523_TCOMP_FILTER_SHIFT);
+    }
+    tc->lastUpdateMs = nowMs;
+
+    tc->deviationPpb = pcf8523_tcomp_deviation_ppb(&tc->config, tc->tempMilliC);
+
+    // Correction in thousandths of a step, the offset cancels the deviation
+    int64_t ideal = pcf8523_tcomp_div_round(-(int64_t)tc->deviationPpb * 1000,
+                                            pcf8523_tcomp_step_ppb(tc->config.mode));
+    if (ideal < PCF8523_TCOMP_OFFSET_MIN * 1000)
+        ideal = PCF8523_TCOMP_OFFSET_MIN * 1000;
+    if (ideal > PCF8523_TCOMP_OFFSET_MAX * 1000)
+        ideal = PCF8523_TCOMP_OFFSET_MAX * 1000;
+
+    int8_t target = (int8_t)pcf8523_tcomp_div_round(ideal, 1000);
+
+    if (tc->synced) {
+        int64_t distance = ideal - (int64_t)tc->offset * 1000;
+        if (distance < 0)
+            distance = -distance;
+
+        if (target == tc->offset || distance < 500 + PCF8523_TCOMP_HYSTERESIS)
+            return true;
+
+        if (tc->writes > 0 && nowMs - tc->lastWriteMs < tc->config.minIntervalMs) {
+            tc->deferred++;
+            return true;
+        }
+    }
+
+    if (!pcf8523_set_offset(tc->pcf8523, tc->config.mode, target))
+        return false;
+
+    tc->offset = target;
+    tc->synced = true;
+    tc->lastWriteMs = nowMs;
+    tc->writes++;
+
+    if (tc->log) {
+        pcf8523_TcompRecord_t record = {
+            .tempMilliC = tc->tempMilliC,
+            .deviationPpb = tc->deviationPpb,
+            .offset = tc->offset,
+            .correctionNs = tc->correctionNs,
+            .writes = tc->writes,
+        };
+        tc->log(tc->logCtx, &record);
+    }
+
+    return true;
+}
@@ -0,0 +1,34 @@
+#include "hardware/adc.h"
+#include "sensor/pcf8523_tcomp.h"
+
+#ifdef ADC_TEMPERATURE_CHANNEL_NUM
+#define PCF8523_TCOMP_ADC_CHANNEL ADC_TEMPERATURE_CHANNEL_NUM
+#else
+#define PCF8523_TCOMP_ADC_CHANNEL 4
+#endif
+
+#define PCF8523_TCOMP_ADC_SAMPLES 16
+#define PCF8523_TCOMP_ADC_VREF_UV 3300000
+
+// Datasheet transfer function: T = 27 - (Vbe - 0.706 V) / 1.721 mV/°C
+#define PCF8523_TCOMP_VBE_27C_UV 706000
+#define PCF8523_TCOMP_VBE_SLOPE_NV 1721000
+
+void pcf8523_tcomp_adc_init(void) {
+    adc_init();
+    adc_set_temp_sensor_enabled(true);
+}
+
+int32_t pcf8523_tcomp_read_temp_adc(void) {
+    adc_select_input(PCF8523_TCOMP_ADC_CHANNEL);
+
+    // The sensor reading is noisy, the average keeps the filter in pcf8523_tcomp_update short
+    uint32_t sum = 0;
+    for (uint8_t i = 0; i < PCF8523_TCOMP_ADC_SAMPLES; i++)
+        sum += adc_read();
+
+    int64_t uv = ((int64_t)sum * PCF8523_TCOMP_ADC_VREF_UV) / (4096 * PCF8523_TCOMP_ADC_SAMPLES);
+
+    return (int32_t)(27000 - ((uv - PCF8523_TCOMP_VBE_27C_UV) * 1000000) /
+                                 PCF8523_TCOMP_VBE_SLOPE_NV);
+}
@@ -0,0 +1,364 @@
+#include "sensor/pcf8523_telemetry.h"
+#include "pcf8523_private.h"
+#include "sensor/pcf8523.h"
+
+#include <string.h>
+
+#define PCF8523_TELEMETRY_SEQ_SIZE 2
+#define PCF8523_TELEMETRY_CRC_SIZE 2
+#define PCF8523_TELEMETRY_RECORD_HEADER 2
+
+#define PCF8523_TELEMETRY_TIME_SIZE 10
+#define PCF8523_TELEMETRY_REGISTERS_SIZE (4 + PCF8523_REGISTER_COUNT)
+#define PCF8523_TELEMETRY_EVENT_SIZE 10
+
+// CRC16-CCITT (polynomial 0x1021, initial value 0xFFFF), one table lookup per byte
+static const uint16_t pcf8523TelemetryCrcTable[256] = {
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+    0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF,
+    0x1231, 0x0210, 0x3273, 0x2252, 0x52B5, 0x4294, 0x72F7, 0x62D6,
+    0x9339, 0x8318, 0xB37B, 0xA35A, 0xD3BD, 0xC39C, 0xF3FF, 0xE3DE,
+    0x2462, 0x3443, 0x0420, 0x1401, 0x64E6, 0x74C7, 0x44A4, 0x5485,
+    0xA56A, 0xB54B, 0x8528, 0x9509, 0xE5EE, 0xF5CF, 0xC5AC, 0xD58D,
+    0x3653, 0x2672, 0x1611, 0x0630, 0x76D7, 0x66F6, 0x5695, 0x46B4,
+    0xB75B, 0xA77A, 0x9719, 0x8738, 0xF7DF, 0xE7FE, 0xD79D, 0xC7BC,
+    0x48C4, 0x58E5, 0x6886, 0x78A7, 0x0840, 0x1861, 0x2802, 0x3823,
+    0xC9CC, 0xD9ED, 0xE98E, 0xF9AF, 0x8948, 0x9969, 0xA90A, 0xB92B,
+    0x5AF5, 0x4AD4, 0x7AB7, 0x6A96, 0x1A71, 0x0A50, 0x3A33, 0x2A12,
+    0xDBFD, 0xCBDC, 0xFBBF, 0xEB9E, 0x9B79, 0x8B58, 0xBB3B, 0xAB1A,
+    0x6CA6, 0x7C87, 0x4CE4, 0x5CC5, 0x2C22, 0x3C03, 0x0C60, 0x1C41,
+    0xEDAE, 0xFD8F, 0xCDEC, 0xDDCD, 0xAD2A, 0xBD0B, 0x8D68, 0x9D49,
+    0x7E97, 0x6EB6, 0x5ED5, 0x4EF4, 0x3E13, 0x2E32, 0x1E51, 0x0E70,
+    0xFF9F, 0xEFBE, 0xDFDD, 0xCFFC, 0xBF1B, 0xAF3A, 0x9F59, 0x8F78,
+    0x9188, 0x81A9, 0xB1CA, 0xA1EB, 0xD10C, 0xC12D, 0xF14E, 0xE16F,
+    0x1080, 0x00A1, 0x30C2, 0x20E3, 0x5004, 0x4025, 0x7046, 0x6067,
+    0x83B9, 0x9398, 0xA3FB, 0xB3DA, 0xC33D, 0xD31C, 0xE37F, 0xF35E,
+    0x02B1, 0x1290, 0x22F3, 0x32D2, 0x4235, 0x5214, 0x6277, 0x7256,
+    0xB5EA, 0xA5CB, 0x95A8, 0x8589, 0xF56E, 0xE54F, 0xD52C, 0xC50D,
+    0x34E2, 0x24C3, 0x14A0, 0x0481, 0x7466, 0x6447, 0x5424, 0x4405,
+    0xA7DB, 0xB7FA, 0x8799, 0x97B8, 0xE75F, 0xF77E, 0xC71D, 0xD73C,
+    0x26D3, 0x36F2, 0x0691, 0x16B0, 0x6657, 0x7676, 0x4615, 0x5634,
+    0xD94C, 0xC96D, 0xF90E, 0xE92F, 0x99C8, 0x89E9, 0xB98A, 0xA9AB,
+    0x5844, 0x4865, 0x7806, 0x6827, 0x18C0, 0x08E1, 0x3882, 0x28A3,
+    0xCB7D, 0xDB5C, 0xEB3F, 0xFB1E, 0x8BF9, 0x9BD8, 0xABBB, 0xBB9A,
+    0x4A75, 0x5A54, 0x6A37, 0x7A16, 0x0AF1, 0x1AD0, 0x2AB3, 0x3A92,
+    0xFD2E, 0xED0F, 0xDD6C, 0xCD4D, 0xBDAA, 0xAD8B, 0x9DE8, 0x8DC9,
+    0x7C26, 0x6C07, 0x5C64, 0x4C45, 0x3CA2, 0x2C83, 0x1CE0, 0x0CC1,
+    0xEF1F, 0xFF3E, 0xCF5D, 0xDF7C, 0xAF9B, 0xBFBA, 0x8FD9, 0x9FF8,
+    0x6E17, 0x7E36, 0x4E55, 0x5E74, 0x2E93, 0x3EB2, 0x0ED1, 0x1EF0,
+};
+
+static uint16_t pcf8523_telemetry_crc16(const uint8_t *data, size_t len) {
+    uint16_t crc = 0xFFFF;
+
+    for (size_t i = 0; i < len; i++)
+        crc = (uint16_t)((crc << 8) ^ pcf8523TelemetryCrcTable[(crc >> 8) ^ data[i]]);
+
+    return crc;
+}
+
+bool pcf8523_telemetry_encoder_init(pcf8523_TelemetryEncoder_t *enc, pcf8523_TelemetrySink_t sink,
+                                    void *ctx) {
+    if (!enc || !sink)
+        return false;
+
+    enc->sink = sink;
+    enc->ctx = ctx;
+    enc->len = PCF8523_TELEMETRY_SEQ_SIZE;
+    enc->seq = 0;
+    enc->frames = 0;
+    enc->records = 0;
+    enc->bytes = 0;
+
+    return true;
+}
+
+bool pcf8523_telemetry_flush(pcf8523_TelemetryEncoder_t *enc) {
+    if (!enc)
+        return false;
+
+    if (enc->len <= PCF8523_TELEMETRY_SEQ_SIZE)
+        return true;
+
+    pcf8523_put_le16(enc->frame, enc->seq);
+    pcf8523_put_le16(&enc->frame[enc->len], pcf8523_telemetry_crc16(enc->frame, enc->len));
+    size_t frameLen = enc->len + PCF8523_TELEMETRY_CRC_SIZE;
+
+    // COBS: every code byte is the distance to the next zero, which it replaces
+    uint8_t out[PCF8523_TELEMETRY_MAX_ENCODED];
+    size_t codePos = 0;
+    size_t outLen = 1;
+    uint8_t code = 1;
+
+    for (size_t i = 0; i < frameLen; i++) {
+        if (enc->frame[i] == 0) {
+            out[codePos] = code;
+            codePos = outLen++;
+            code = 1;
+        }
+        else {
+            out[outLen++] = enc->frame[i];
+            code++;
+        }
+    }
+
+    out[codePos] = code;
+    out[outLen++] = 0x00;
+
+    enc->sink(enc->ctx, out, outLen);
+
+    enc->frames++;
+    enc->bytes += (uint32_t)outLen;
+    enc->seq++;
+    enc->len = PCF8523_TELEMETRY_SEQ_SIZE;
+
+    return true;
+}
+
+bool pcf8523_telemetry_add(pcf8523_TelemetryEncoder_t *enc, uint8_t type, const uint8_t *body,
+                           uint8_t len) {
+    if (!enc || (!body && len > 0) || len > PCF8523_TELEMETRY_MAX_BODY)
+        return false;
+
+    size_t needed = PCF8523_TELEMETRY_RECORD_HEADER + len;
+    if (enc->len + needed > PCF8523_TELEMETRY_MAX_FRAME - PCF8523_TELEMETRY_CRC_SIZE &&
+        !pcf8523_telemetry_flush(enc))
+        return false;
+
+    uint8_t *dst = &enc->frame[enc->len];
+    dst[0] = type;
+    dst[1] = len;
+    if (len > 0)
+        memcpy(&dst[PCF8523_TELEMETRY_RECORD_HEADER], body, len);
+
+    enc->len += needed;
+    enc->records++;
+
+    return true;
+}
+
+bool pcf8523_telemetry_add_time(pcf8523_TelemetryEncoder_t *enc, uint32_t epoch, uint32_t clockUs,
+                                uint16_t health) {
+    uint8_t body[PCF8523_TELEMETRY_TIME_SIZE];
+
+    pcf8523_put_le32(&body[0], epoch);
+    pcf8523_put_le32(&body[4], clockUs);
+    pcf8523_put_le16(&body[8], health);
+
+    return pcf8523_telemetry_add(enc, PCF8523_TELEMETRY_TIME, body, sizeof(body));
+}
+
+bool pcf8523_telemetry_add_event(pcf8523_TelemetryEncoder_t *enc, uint32_t clockUs, uint16_t code,
+                                 uint32_t arg) {
+    uint8_t body[PCF8523_TELEMETRY_EVENT_SIZE];
+
+    pcf8523_put_le32(&body[0], clockUs);
+    pcf8523_put_le16(&body[4], code);
+    pcf8523_put_le32(&body[6], arg);
+
+    return pcf8523_telemetry_add(enc, PCF8523_TELEMETRY_EVENT, body, sizeof(body));
+}
+
+bool pcf8523_telemetry_sample_time(pcf8523_TelemetryEncoder_t *enc, pcf8523_t *pcf8523,
+                                   uint16_t century, uint32_t clockUs) {
+    if (!enc || !pcf8523)
+        return false;
+
+    pcf8523_Datetime_t datetime;
+    uint16_t health;
+
+    if (!pcf8523_read_datetime_health(pcf8523, &datetime, &health))
+        return false;
+
+    uint64_t epoch = pcf8523_datetime_to_epoch(&datetime, century);
+
+    return pcf8523_telemetry_add_time(enc, (uint32_t)epoch, clockUs, health);
+}
+
+bool pcf8523_telemetry_sample_registers(pcf8523_TelemetryEncoder_t *enc, pcf8523_t *pcf8523,
+                                        uint32_t clockUs) {
+    if (!enc || !pcf8523)
+        return false;
+
+    uint8_t body[PCF8523_TELEMETRY_REGISTERS_SIZE];
+
+    pcf8523_put_le32(&body[0], clockUs);
+    if (!pcf8523_read_block(pcf8523, PCF8523_CTRL1_REG, &body[4], PCF8523_REGISTER_COUNT))
+        return false;
+
+    return pcf8523_telemetry_add(enc, PCF8523_TELEMETRY_REGISTERS, body, sizeof(body));
+}
+
+bool pcf8523_telemetry_decoder_init(pcf8523_TelemetryDecoder_t *dec,
+                                    pcf8523_TelemetryHandler_t handler, void *ctx) {
+    if (!dec || !handler)
+        return false;
+
+    memset(dec, 0, sizeof(*dec));
+    dec->handler = handler;
+    dec->ctx = ctx;
+
+    return true;
+}
+
+static void pcf8523_telemetry_reset_frame(pcf8523_TelemetryDecoder_t *dec) {
+    dec->len = 0;
+    dec->remaining = 0;
+    dec->zeroPending = false;
+    dec->overflow = false;
+}
+
+static inline void pcf8523_telemetry_append(pcf8523_TelemetryDecoder_t *dec, const uint8_t *data,
+                                            size_t len) {
+    if (dec->overflow || dec->len + len > PCF8523_TELEMETRY_MAX_FRAME) {
+        dec->overflow = true;
+        return;
+    }
+
+    memcpy(&dec->frame[dec->len], data, len);
+    dec->len += len;
+}
+
+static void pcf8523_telemetry_end_frame(pcf8523_TelemetryDecoder_t *dec) {
+    size_t len = dec->len;
+    bool overflow = dec->overflow;
+    bool midBlock = dec->remaining > 0;
+
+    pcf8523_telemetry_reset_frame(dec);
+
+    // Back to back delimiters
+    if (len == 0 && !overflow && !midBlock)
+        return;
+
+    if (overflow || midBlock || len < PCF8523_TELEMETRY_SEQ_SIZE + PCF8523_TELEMETRY_CRC_SIZE) {
+        dec->malformed++;
+        return;
+    }
+
+    size_t end = len - PCF8523_TELEMETRY_CRC_SIZE;
+    if (pcf8523_telemetry_crc16(dec->frame, end) != pcf8523_get_le16(&dec->frame[end])) {
+        dec->crcErrors++;
+        return;
+    }
+
+    // The whole record layout is checked before anything is handed out
+    size_t pos = PCF8523_TELEMETRY_SEQ_SIZE;
+    while (pos < end) {
+        if (pos + PCF8523_TELEMETRY_RECORD_HEADER > end ||
+            pos + PCF8523_TELEMETRY_RECORD_HEADER + dec->frame[pos + 1] > end) {
+            dec->malformed++;
+            return;
+        }
+        pos += PCF8523_TELEMETRY_RECORD_HEADER + dec->frame[pos + 1];
+    }
+
+    uint16_t seq = pcf8523_get_le16(dec->frame);
+    if (dec->synced)
+        dec->lostFrames += (uint16_t)(seq - dec->nextSeq);
+    dec->synced = true;
+    dec->nextSeq = (uint16_t)(seq + 1);
+    dec->frames++;
+
+    pcf8523_TelemetryRecord_t record = {.frameSeq = seq};
+    pos = PCF8523_TELEMETRY_SEQ_SIZE;
+    while (pos < end) {
+        record.type = dec->frame[pos];
+        record.len = dec->frame[pos + 1];
+        record.body = &dec->frame[pos + PCF8523_TELEMETRY_RECORD_HEADER];
+        pos += PCF8523_TELEMETRY_RECORD_HEADER + record.len;
+
+        dec->records++;
+        dec->handler(dec->ctx, &record);
+    }
+}
+
+void pcf8523_telemetry_decode(pcf8523_TelemetryDecoder_t *dec, const uint8_t *data, size_t len) {
+    if (!dec || !data)
+        return;
+
+    size_t i = 0;
+    while (i < len) {
+        if (dec->remaining == 0) {
+            uint8_t code = data[i++];
+
+            if (code == 0) {
+                pcf8523_telemetry_end_frame(dec);
+                continue;
+            }
+
+            if (dec->zeroPending) {
+                static const uint8_t zero = 0;
+                pcf8523_telemetry_append(dec, &zero, 1);
+            }
+
+            dec->remaining = (uint8_t)(code - 1);
+            dec->zeroPending = code != 0xFF;
+            continue;
+        }
+
+        // The data run of the block is copied in one go, a 0x00 inside it cuts the frame short
+        size_t run = dec->remaining;
+        if (run > len - i)
+            run = len - i;
+
+        const uint8_t *zero = memchr(&data[i], 0, run);
+        if (zero) {
+            run = (size_t)(zero - &data[i]);
+            pcf8523_telemetry_append(dec, &data[i], run);
+            dec->remaining = (uint8_t)(dec->remaining - run);
+            i += run + 1;
+            pcf8523_telemetry_end_frame(dec);
+            continue;
+        }
+
+        pcf8523_telemetry_append(dec, &data[i], run);
+        dec->remaining = (uint8_t)(dec->remaining - run);
+        i += run;
+    }
+}
+
+bool pcf8523_telemetry_parse_time(const pcf8523_TelemetryRecord_t *record, uint32_t *epoch,
+                                  uint32_t *clockUs, uint16_t *health) {
+    if (!record || record->type != PCF8523_TELEMETRY_TIME ||
+        record->len < PCF8523_TELEMETRY_TIME_SIZE)
+        return false;
+
+    if (epoch)
+        *epoch = pcf8523_get_le32(&record->body[0]);
+    if (clockUs)
+        *clockUs = pcf8523_get_le32(&record->body[4]);
+    if (health)
+        *health = pcf8523_get_le16(&record->body[8]);
+
+    return true;
+}
+
+bool pcf8523_telemetry_parse_registers(const pcf8523_TelemetryRecord_t *record, uint32_t *clockUs,
+                                       uint8_t *registers) {
+    if (!record || record->type != PCF8523_TELEMETRY_REGISTERS ||
+        record->len < PCF8523_TELEMETRY_REGISTERS_SIZE)
+        return false;
+
+    if (clockUs)
+        *clockUs = pcf8523_get_le32(&record->body[0]);
+    if (registers)
+        memcpy(registers, &record->body[4], PCF8523_REGISTER_COUNT);
+
+    return true;
+}
+
+bool pcf8523_telemetry_parse_event(const pcf8523_TelemetryRecord_t *record, uint32_t *clockUs,
+                                   uint16_t *code, uint32_t *arg) {
+    if (!record || record->type != PCF8523_TELEMETRY_EVENT ||
+        record->len < PCF8523_TELEMETRY_EVENT_SIZE)
+        return false;
+
+    if (clockUs)
+        *clockUs = pcf8523_get_le32(&record->body[0]);
+    if (code)
+        *code = pcf8523_get_le16(&record->body[4]);
+    if (arg)
+        *arg = pcf8523_get_le32(&record->body[6]);
+
+    return true;
+}
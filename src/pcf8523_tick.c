@@ -0,0 +1,201 @@
+#include "sensor/pcf8523_tick.h"
+#include "pico/stdlib.h"
+#include "sensor/pcf8523.h"
+
+static void pcf8523_tick_reset(pcf8523_TickEngine_t *engine, pcf8523_t *pcf8523,
+                               pcf8523_TickSource_t source, uint64_t tickNs) {
+    engine->pcf8523 = pcf8523;
+    engine->source = source;
+    engine->tickNs = tickNs;
+    engine->irqTicks = 0;
+    engine->lastEdgeUs = 0;
+    engine->tick = 0;
+    engine->lateTicks = 0;
+    engine->taskCount = 0;
+
+    for (uint8_t i = 0; i < PCF8523_TICK_WHEEL_SIZE; i++)
+        engine->wheel[i] = PCF8523_TICK_NO_TASK;
+}
+
+static void pcf8523_tick_insert(pcf8523_TickEngine_t *engine, uint8_t id) {
+    uint8_t slot = (uint8_t)(engine->tasks[id].dueTick % PCF8523_TICK_WHEEL_SIZE);
+
+    engine->tasks[id].next = engine->wheel[slot];
+    engine->wheel[slot] = id;
+}
+
+bool pcf8523_tick_start_second(pcf8523_TickEngine_t *engine, pcf8523_t *pcf8523) {
+    if (!engine || !pcf8523)
+        return false;
+
+    pcf8523_tick_reset(engine, pcf8523, PCF8523_TICK_SOURCE_SECOND, 1000000000ULL);
+
+    // Pulsed mode, so INT1 fires every second without clearing SF over the bus
+    if (!pcf8523_set_timer_int_mode(pcf8523, PCF8523_TMR_A_TMR_SEC, PCF8523_TMR_PULSED_INT))
+        return false;
+
+    return pcf8523_enable_interrupt_source(pcf8523, PCF8523_CTRL1_REG,
+                                           PCF8523_CTRL1_ENABLE_SECOND_INT_MASK, true);
+}
+
+bool pcf8523_tick_start_timer_b(pcf8523_TickEngine_t *engine, pcf8523_t *pcf8523,
+                                pcf8523_ClkSourceFreq_t sourceFreq, uint8_t value) {
+    if (!engine || !pcf8523 || value == 0)
+        return false;
+
+    uint64_t tickNs;
+    if (sourceFreq == PCF8523_CLK_SOURCE_FREQ_4096_HZ)
+        tickNs = ((uint64_t)value * 1000000000ULL) / 4096ULL;
+    else
+        tickNs = pcf8523_timer_duration_us(sourceFreq, value) * 1000ULL;
+
+    pcf8523_tick_reset(engine, pcf8523, PCF8523_TICK_SOURCE_TIMER_B, tickNs);
+
+    // The device shortens the pulse on its own when the period is below the selected width
+    pcf8523_TimerBValue tmrB = {
+        .sourceFreq = sourceFreq,
+        .intWidth = PCF8523_TMR_B_INT_WIDTH_46_875_MS,
+        .value = value,
+    };
+
+    if (!pcf8523_set_timer_b_mode(pcf8523, false))
+        return false;
+
+    if (!pcf8523_set_timer_int_mode(pcf8523, PCF8523_TMR_B, PCF8523_TMR_PULSED_INT))
+        return false;
+
+    if (!pcf8523_set_timer_b_duration(pcf8523, &tmrB))
+        return false;
+
+    if (!pcf8523_enable_interrupt_source(pcf8523, PCF8523_CTRL2_REG,
+                                         PCF8523_CTRL2_ENABLE_COUNTDOWN_TMR_B_INT_MASK, true))
+        return false;
+
+    return pcf8523_set_timer_b_mode(pcf8523, true);
+}
+
+bool pcf8523_tick_stop(pcf8523_TickEngine_t *engine) {
+    if (!engine || !engine->pcf8523)
+        return false;
+
+    if (engine->source == PCF8523_TICK_SOURCE_SECOND)
+        return pcf8523_enable_interrupt_source(engine->pcf8523, PCF8523_CTRL1_REG,
+                                               PCF8523_CTRL1_ENABLE_SECOND_INT_MASK, false);
+
+    if (!pcf8523_enable_interrupt_source(engine->pcf8523, PCF8523_CTRL2_REG,
+                                         PCF8523_CTRL2_ENABLE_COUNTDOWN_TMR_B_INT_MASK, false))
+        return false;
+
+    return pcf8523_set_timer_b_mode(engine->pcf8523, false);
+}
+
+bool pcf8523_tick_add(pcf8523_TickEngine_t *engine, uint32_t periodTicks,
+                      pcf8523_TickCallback_t callback, void *userData, uint8_t *id) {
+    if (!engine || !callback || periodTicks == 0)
+        return false;
+
+    if (engine->taskCount >= PCF8523_TICK_MAX_TASKS)
+        return false;
+
+    uint8_t newId = engine->taskCount;
+    pcf8523_TickTask_t *task = &engine->tasks[newId];
+
+    task->callback = callback;
+    task->userData = userData;
+    task->periodTicks = periodTicks;
+    task->dueTick = engine->tick + periodTicks;
+    task->lastRunUs = 0;
+    task->stats = (pcf8523_TickStats_t){0};
+
+    pcf8523_tick_insert(engine, newId);
+    engine->taskCount++;
+
+    if (id)
+        *id = newId;
+
+    return true;
+}
+
+void pcf8523_tick_handle_irq(pcf8523_TickEngine_t *engine) {
+    if (!engine)
+        return;
+
+    engine->lastEdgeUs = time_us_32();
+    engine->irqTicks++;
+}
+
+static void pcf8523_tick_run(pcf8523_TickEngine_t *engine, pcf8523_TickTask_t *task, bool late) {
+    uint64_t now = time_us_64();
+    pcf8523_TickStats_t *stats = &task->stats;
+
+    if (task->lastRunUs != 0) {
+        int64_t nominalUs = (int64_t)((task->periodTicks * engine->tickNs) / 1000ULL);
+        int64_t jitter = (int64_t)(now - task->lastRunUs) - nominalUs;
+
+        if (stats->runs == 1 || jitter < stats->minJitterUs)
+            stats->minJitterUs = jitter;
+        if (stats->runs == 1 || jitter > stats->maxJitterUs)
+            stats->maxJitterUs = jitter;
+    }
+
+    if (late) {
+        stats->overruns++;
+    }
+    else {
+        uint32_t latency = (uint32_t)now - engine->lastEdgeUs;
+        if (latency > stats->maxLatencyUs)
+            stats->maxLatencyUs = latency;
+    }
+
+    stats->runs++;
+    task->lastRunUs = now;
+    task->callback(task->userData);
+}
+
+uint32_t pcf8523_tick_poll(pcf8523_TickEngine_t *engine) {
+    if (!engine)
+        return 0;
+
+    uint32_t target = engine->irqTicks;
+    uint32_t ran = 0;
+
+    while ((int32_t)(target - engine->tick) > 0) {
+        engine->tick++;
+
+        // More edges are already pending, so whatever runs on this tick runs late
+        bool late = engine->tick != target;
+        if (late)
+            engine->lateTicks++;
+
+        uint8_t slot = (uint8_t)(engine->tick % PCF8523_TICK_WHEEL_SIZE);
+        uint8_t id = engine->wheel[slot];
+        engine->wheel[slot] = PCF8523_TICK_NO_TASK;
+
+        while (id != PCF8523_TICK_NO_TASK) {
+            pcf8523_TickTask_t *task = &engine->tasks[id];
+            uint8_t next = task->next;
+
+            // Tasks further than one wheel turn away just go back to their slot
+            if (task->dueTick == engine->tick) {
+                pcf8523_tick_run(engine, task, late);
+                task->dueTick += task->periodTicks;
+                ran++;
+            }
+            pcf8523_tick_insert(engine, id);
+
+            id = next;
+        }
+    }
+
+    return ran;
+}
+
+bool pcf8523_tick_read_stats(const pcf8523_TickEngine_t *engine, uint8_t id,
+                             pcf8523_TickStats_t *stats) {
+    if (!engine || !stats || id >= engine->taskCount)
+        return false;
+
+    *stats = engine->tasks[id].stats;
+
+    return true;
+}
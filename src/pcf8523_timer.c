@@ -0,0 +1,162 @@
+#include "pcf8523_private.h"
+#include "sensor/pcf8523.h"
+
+bool pcf8523_set_timer_a_mode(pcf8523_t *pcf8523, pcf8523_TmrAMode_t mode) {
+    if (!pcf8523)
+        return false;
+
+    uint8_t buffer;
+
+    if (!pcf8523_read_register(pcf8523, PCF8523_TMR_CTRL_REG, &buffer))
+        return false;
+
+    buffer &= (uint8_t)(~PCF8523_TMR_CTRL_TMR_A_MODE_MASK);
+    buffer |= (uint8_t)(mode);
+
+    if (!pcf8523_write_register(pcf8523, PCF8523_TMR_CTRL_REG, buffer))
+        return false;
+
+    return true;
+}
+
+bool pcf8523_read_timer_a_mode(pcf8523_t *pcf8523, pcf8523_TmrAMode_t *mode) {
+    if (!pcf8523 || !mode)
+        return false;
+
+    uint8_t buffer;
+
+    if (!pcf8523_read_register(pcf8523, PCF8523_TMR_CTRL_REG, &buffer))
+        return false;
+
+    buffer &= PCF8523_TMR_CTRL_TMR_A_MODE_MASK;
+
+    *mode = (pcf8523_TmrAMode_t)buffer;
+
+    return true;
+}
+
+bool pcf8523_set_timer_b_mode(pcf8523_t *pcf8523, bool enable) {
+    if (!pcf8523)
+        return false;
+
+    return pcf8523_set_bit(pcf8523, PCF8523_TMR_CTRL_REG, PCF8523_TMR_CTRL_TMR_B_ENABLED_MASK,
+                           enable);
+}
+
+bool pcf8523_read_timer_b_mode(pcf8523_t *pcf8523, bool *enabled) {
+    if (!pcf8523 || !enabled)
+        return false;
+
+    return pcf8523_read_bit(pcf8523, PCF8523_TMR_CTRL_REG, PCF8523_TMR_CTRL_TMR_B_ENABLED_MASK,
+                            enabled);
+}
+
+bool pcf8523_set_timer_int_mode(pcf8523_t *pcf8523, pcf8523_Tmr_t tmr, pcf8523_TmrIntMode intMode) {
+    if (!pcf8523)
+        return false;
+
+    uint8_t pinMask;
+    if (tmr == PCF8523_TMR_A_TMR_SEC)
+        pinMask = PCF8523_TMR_CTRL_PERM_TMR_A_TMR_SEC_INT_MASK;
+    else
+        pinMask = PCF8523_TMR_CTRL_PERM_TMR_B_INT_MASK;
+
+    if (!pcf8523_set_bit(pcf8523, PCF8523_TMR_CTRL_REG, pinMask, intMode))
+        return false;
+
+    return true;
+}
+
+bool pcf8523_read_timer_int_mode(pcf8523_t *pcf8523, pcf8523_Tmr_t tmr,
+                                 pcf8523_TmrIntMode *intMode) {
+    if (!pcf8523 || !intMode)
+        return false;
+
+    return pcf8523_read_bit(pcf8523, PCF8523_TMR_CTRL_REG, tmr, (bool *)intMode);
+}
+
+bool pcf8523_set_timer_a_duration(pcf8523_t *pcf8523, pcf8523_TimerAValue *tmrA) {
+    if (!pcf8523 || !tmrA)
+        return false;
+
+    uint8_t frame[PCF8523_FRAME_SIZE(2)];
+    pcf8523_Transaction_t tx;
+    if (!pcf8523_transaction_init(&tx, PCF8523_TMR_A_FREQ_CTRL_REG, frame, 2, true))
+        return false;
+
+    frame[1] = tmrA->sourceFreq;
+    frame[2] = tmrA->value;
+
+    if (!pcf8523_execute(pcf8523, &tx))
+        return false;
+
+    return true;
+}
+
+bool pcf8523_read_timer_a_duration(pcf8523_t *pcf8523, pcf8523_TimerAValue *tmrA) {
+    if (!pcf8523 || !tmrA)
+        return false;
+
+    uint8_t buffer[2];
+
+    if (!pcf8523_read_block(pcf8523, PCF8523_TMR_A_FREQ_CTRL_REG, buffer, 2))
+        return false;
+
+    tmrA->sourceFreq = (pcf8523_ClkSourceFreq_t)buffer[0];
+    tmrA->value = buffer[1];
+
+    return true;
+}
+
+bool pcf8523_set_timer_b_duration(pcf8523_t *pcf8523, pcf8523_TimerBValue *tmrB) {
+    if (!pcf8523 || !tmrB)
+        return false;
+
+    uint8_t frame[PCF8523_FRAME_SIZE(2)];
+    pcf8523_Transaction_t tx;
+    if (!pcf8523_transaction_init(&tx, PCF8523_TMR_B_FREQ_CTRL_REG, frame, 2, true))
+        return false;
+
+    frame[1] = tmrB->intWidth;
+    frame[1] |= (uint8_t)tmrB->sourceFreq;
+    frame[2] = tmrB->value;
+
+    if (!pcf8523_execute(pcf8523, &tx))
+        return false;
+
+    return true;
+}
+
+bool pcf8523_read_timer_b_duration(pcf8523_t *pcf8523, pcf8523_TimerBValue *tmrB) {
+    if (!pcf8523 || !tmrB)
+        return false;
+
+    uint8_t buffer[2];
+
+    if (!pcf8523_read_block(pcf8523, PCF8523_TMR_B_FREQ_CTRL_REG, buffer, 2))
+        return false;
+
+    uint8_t widthBuf = buffer[0] & PCF8523_TMR_B_INT_WIDTH_MASK;
+    tmrB->intWidth = (pcf8523_TmrBIntWidth_t)(widthBuf >> 4);
+
+    tmrB->sourceFreq = (pcf8523_ClkSourceFreq_t)(buffer[0] & PCF8523_TMR_B_INT_WIDTH_MASK);
+
+    tmrB->value = buffer[1];
+
+    return true;
+}
+
+uint64_t pcf8523_timer_duration_us(pcf8523_ClkSourceFreq_t sourceFreq, uint8_t value) {
+    switch (sourceFreq) {
+        case PCF8523_CLK_SOURCE_FREQ_4096_HZ:
+            return ((uint64_t)value * 1000000ULL) / 4096ULL;
+        case PCF8523_CLK_SOURCE_FREQ_64_HZ:
+            return ((uint64_t)value * 1000000ULL) / 64ULL;
+        case PCF8523_CLK_SOURCE_FREQ_1_HZ:
+            return (uint64_t)value * 1000000ULL;
+        case PCF8523_CLK_SOURCE_FREQ_1_DIV_60_HZ:
+            return (uint64_t)value * 60000000ULL;
+        default: // All the remaining values select 1/3600 Hz
+            return (uint64_t)value * 3600000000ULL;
+    }
+}
@@ -0,0 +1,220 @@
+#include "sensor/pcf8523_trace.h"
+#include "sensor/pcf8523.h"
+#include <string.h>
+
+static const uint8_t pcf8523TraceMagic[4] = {'P', 'T', 'R', 'C'};
+
+static void pcf8523_trace_put_u32(uint8_t *dst, uint32_t value) {
+    dst[0] = (uint8_t)value;
+    dst[1] = (uint8_t)(value >> 8);
+    dst[2] = (uint8_t)(value >> 16);
+    dst[3] = (uint8_t)(value >> 24);
+}
+
+static uint32_t pcf8523_trace_get_u32(const uint8_t *src) {
+    return (uint32_t)src[0] | ((uint32_t)src[1] << 8) | ((uint32_t)src[2] << 16) |
+           ((uint32_t)src[3] << 24);
+}
+
+static inline size_t pcf8523_trace_tail(const pcf8523_Trace_t *trace) {
+    return (trace->head + trace->size - trace->used) % trace->size;
+}
+
+static void pcf8523_trace_drop_oldest(pcf8523_Trace_t *trace) {
+    size_t lenPos = (pcf8523_trace_tail(trace) + 3) % trace->size;
+    size_t recordSize = PCF8523_TRACE_RECORD_OVERHEAD + trace->buffer[lenPos];
+
+    trace->used -= recordSize;
+    trace->records--;
+    trace->dropped++;
+}
+
+static void pcf8523_trace_append(pcf8523_Trace_t *trace, uint8_t flags, uint8_t i2cAddress,
+                                 uint8_t reg, const uint8_t *payload, size_t len,
+                                 uint32_t startUs) {
+    uint8_t record[PCF8523_TRACE_RECORD_OVERHEAD + PCF8523_TRACE_MAX_PAYLOAD];
+    uint32_t durationUs = trace->clock ? trace->clock() - startUs : 0;
+
+    if (len > PCF8523_TRACE_MAX_PAYLOAD) {
+        len = PCF8523_TRACE_MAX_PAYLOAD;
+        flags |= PCF8523_TRACE_FLAG_TRUNCATED;
+    }
+
+    size_t recordSize = PCF8523_TRACE_RECORD_OVERHEAD + len;
+    if (recordSize > trace->size) {
+        trace->dropped++;
+        return;
+    }
+
+    record[0] = flags;
+    record[1] = i2cAddress;
+    record[2] = reg;
+    record[3] = (uint8_t)len;
+    pcf8523_trace_put_u32(&record[4], startUs);
+    if (durationUs > UINT16_MAX)
+        durationUs = UINT16_MAX;
+    record[8] = (uint8_t)durationUs;
+    record[9] = (uint8_t)(durationUs >> 8);
+    if (len > 0)
+        memcpy(&record[PCF8523_TRACE_RECORD_OVERHEAD], payload, len);
+
+    while (trace->size - trace->used < recordSize)
+        pcf8523_trace_drop_oldest(trace);
+
+    // The record may wrap around the end of the ring
+    size_t first = trace->size - trace->head;
+    if (first > recordSize)
+        first = recordSize;
+    memcpy(&trace->buffer[trace->head], record, first);
+    memcpy(trace->buffer, &record[first], recordSize - first);
+
+    trace->head = (trace->head + recordSize) % trace->size;
+    trace->used += recordSize;
+    trace->records++;
+}
+
+static bool pcf8523_trace_read(void *ctx, uint8_t i2cAddress, uint8_t startReg, uint8_t *data,
+                               size_t len) {
+    pcf8523_Trace_t *trace = (pcf8523_Trace_t *)ctx;
+
+    if (!trace->enabled)
+        return trace->transport->read(trace->transportCtx, i2cAddress, startReg, data, len);
+
+    uint32_t startUs = trace->clock ? trace->clock() : 0;
+    bool ok = trace->transport->read(trace->transportCtx, i2cAddress, startReg, data, len);
+
+    uint8_t flags = ok ? PCF8523_TRACE_FLAG_OK : 0;
+    pcf8523_trace_append(trace, flags, i2cAddress, startReg, data, len, startUs);
+
+    return ok;
+}
+
+static bool pcf8523_trace_write(void *ctx, uint8_t i2cAddress, const uint8_t *frame,
+                                size_t frameLen) {
+    pcf8523_Trace_t *trace = (pcf8523_Trace_t *)ctx;
+
+    if (!trace->enabled || frameLen == 0)
+        return trace->transport->write(trace->transportCtx, i2cAddress, frame, frameLen);
+
+    uint32_t startUs = trace->clock ? trace->clock() : 0;
+    bool ok = trace->transport->write(trace->transportCtx, i2cAddress, frame, frameLen);
+
+    uint8_t flags = PCF8523_TRACE_FLAG_WRITE | (ok ? PCF8523_TRACE_FLAG_OK : 0);
+    pcf8523_trace_append(trace, flags, i2cAddress, frame[0], &frame[1], frameLen - 1, startUs);
+
+    return ok;
+}
+
+static const pcf8523_Transport_t pcf8523_trace_transport = {
+    .read = pcf8523_trace_read,
+    .write = pcf8523_trace_write,
+};
+
+bool pcf8523_trace_init(pcf8523_Trace_t *trace, pcf8523_t *pcf8523, uint8_t *buffer, size_t size,
+                        pcf8523_TraceClock_t clock) {
+    if (!trace || !pcf8523 || !buffer || size < PCF8523_TRACE_RECORD_OVERHEAD)
+        return false;
+
+    trace->transport = pcf8523->transport;
+    trace->transportCtx = pcf8523->transportCtx;
+    trace->clock = clock;
+    trace->buffer = buffer;
+    trace->size = size;
+    trace->enabled = true;
+    pcf8523_trace_clear(trace);
+
+    pcf8523->transport = &pcf8523_trace_transport;
+    pcf8523->transportCtx = trace;
+
+    return true;
+}
+
+void pcf8523_trace_enable(pcf8523_Trace_t *trace, bool enabled) {
+    if (!trace)
+        return;
+
+    trace->enabled = enabled;
+}
+
+void pcf8523_trace_clear(pcf8523_Trace_t *trace) {
+    if (!trace)
+        return;
+
+    trace->head = 0;
+    trace->used = 0;
+    trace->records = 0;
+    trace->dropped = 0;
+}
+
+bool pcf8523_trace_dump(const pcf8523_Trace_t *trace, pcf8523_TraceSink_t sink, void *ctx) {
+    if (!trace || !sink)
+        return false;
+
+    uint8_t header[PCF8523_TRACE_HEADER_SIZE];
+    memcpy(header, pcf8523TraceMagic, sizeof(pcf8523TraceMagic));
+    header[4] = PCF8523_TRACE_VERSION;
+    pcf8523_trace_put_u32(&header[5], trace->records);
+    pcf8523_trace_put_u32(&header[9], trace->dropped);
+    sink(ctx, header, sizeof(header));
+
+    size_t tail = pcf8523_trace_tail(trace);
+    size_t first = trace->size - tail;
+    if (first > trace->used)
+        first = trace->used;
+
+    if (first > 0)
+        sink(ctx, &trace->buffer[tail], first);
+    if (trace->used > first)
+        sink(ctx, trace->buffer, trace->used - first);
+
+    return true;
+}
+
+bool pcf8523_trace_parse_header(const uint8_t *data, size_t len, size_t *pos, uint32_t *records,
+                                uint32_t *dropped) {
+    if (!data || !pos)
+        return false;
+
+    for (size_t i = 0; i + PCF8523_TRACE_HEADER_SIZE <= len; i++) {
+        if (memcmp(&data[i], pcf8523TraceMagic, sizeof(pcf8523TraceMagic)) != 0)
+            continue;
+        if (data[i + 4] != PCF8523_TRACE_VERSION)
+            continue;
+
+        if (records)
+            *records = pcf8523_trace_get_u32(&data[i + 5]);
+        if (dropped)
+            *dropped = pcf8523_trace_get_u32(&data[i + 9]);
+        *pos = i + PCF8523_TRACE_HEADER_SIZE;
+
+        return true;
+    }
+
+    return false;
+}
+
+bool pcf8523_trace_parse(const uint8_t *data, size_t len, size_t *pos,
+                         pcf8523_TraceRecord_t *record) {
+    if (!data || !pos || !record)
+        return false;
+
+    if (*pos + PCF8523_TRACE_RECORD_OVERHEAD > len)
+        return false;
+
+    const uint8_t *src = &data[*pos];
+    if (src[3] > PCF8523_TRACE_MAX_PAYLOAD ||
+        *pos + PCF8523_TRACE_RECORD_OVERHEAD + src[3] > len)
+        return false;
+
+    record->flags = src[0];
+    record->i2cAddress = src[1];
+    record->reg = src[2];
+    record->len = src[3];
+    record->timestampUs = pcf8523_trace_get_u32(&src[4]);
+    record->durationUs = (uint16_t)(src[8] | (src[9] << 8));
+    memcpy(record->payload, &src[PCF8523_TRACE_RECORD_OVERHEAD], record->len);
+
+    *pos += PCF8523_TRACE_RECORD_OVERHEAD + record->len;
+
+    return true;
+}
@@ -0,0 +1,90 @@
+#define _POSIX_C_SOURCE 200809L
+#include "sensor/pcf8523.h"
+#include "sensor/pcf8523_linux.h"
+#include <fcntl.h>
+#include <linux/i2c-dev.h>
+#include <linux/i2c.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+static bool pcf8523_linux_transfer(pcf8523_LinuxI2c_t *bus, struct i2c_msg *msgs, uint32_t count) {
+    struct i2c_rdwr_ioctl_data xfer = {
+        .msgs = msgs,
+        .nmsgs = count,
+    };
+
+    bus->transfers++;
+    if (ioctl(bus->fd, I2C_RDWR, &xfer) != (int)count) {
+        bus->errors++;
+        return false;
+    }
+
+    return true;
+}
+
+static bool pcf8523_linux_write(void *ctx, uint8_t i2cAddress, const uint8_t *frame,
+                                size_t frameLen) {
+    pcf8523_LinuxI2c_t *bus = (pcf8523_LinuxI2c_t *)ctx;
+
+    if (frameLen > PCF8523_FRAME_SIZE(PCF8523_REGISTER_COUNT))
+        return false;
+
+    struct i2c_msg msg = {
+        .addr = i2cAddress,
+        .flags = 0,
+        .len = (uint16_t)frameLen,
+        .buf = (uint8_t *)frame,
+    };
+
+    return pcf8523_linux_transfer(bus, &msg, 1);
+}
+
+static bool pcf8523_linux_read(void *ctx, uint8_t i2cAddress, uint8_t startReg, uint8_t *data,
+                               size_t len) {
+    pcf8523_LinuxI2c_t *bus = (pcf8523_LinuxI2c_t *)ctx;
+
+    if (len > PCF8523_REGISTER_COUNT)
+        return false;
+
+    // Address write and data read joined by a repeated start in one ioctl
+    struct i2c_msg msgs[2] = {
+        {
+            .addr = i2cAddress,
+            .flags = 0,
+            .len = 1,
+            .buf = &startReg,
+        },
+        {
+            .addr = i2cAddress,
+            .flags = I2C_M_RD,
+            .len = (uint16_t)len,
+            .buf = data,
+        },
+    };
+
+    return pcf8523_linux_transfer(bus, msgs, 2);
+}
+
+const pcf8523_Transport_t pcf8523_linux_transport = {
+    .read = pcf8523_linux_read,
+    .write = pcf8523_linux_write,
+};
+
+bool pcf8523_linux_i2c_open(pcf8523_LinuxI2c_t *bus, const char *device) {
+    if (!bus || !device)
+        return false;
+
+    bus->transfers = 0;
+    bus->errors = 0;
+    bus->fd = open(device, O_RDWR | O_CLOEXEC);
+
+    return bus->fd >= 0;
+}
+
+void pcf8523_linux_i2c_close(pcf8523_LinuxI2c_t *bus) {
+    if (!bus || bus->fd < 0)
+        return;
+
+    close(bus->fd);
+    bus->fd = -1;
+}
@@ -0,0 +1,41 @@
+#include "hardware/i2c.h"
+#include "sensor/pcf8523.h"
+
+static bool pcf8523_pico_write(void *ctx, uint8_t i2cAddress, const uint8_t *frame,
+                               size_t frameLen) {
+    i2c_inst_t *i2c = (i2c_inst_t *)ctx;
+
+    if (i2c_write_blocking(i2c, i2cAddress, frame, frameLen, false) != (int)(frameLen))
+        return false;
+
+    return true;
+}
+
+static bool pcf8523_pico_read(void *ctx, uint8_t i2cAddress, uint8_t startReg, uint8_t *data,
+                              size_t len) {
+    i2c_inst_t *i2c = (i2c_inst_t *)ctx;
+
+    if (i2c_write_blocking(i2c, i2cAddress, &startReg, 1, true) != 1)
+        return false;
+
+    if (i2c_read_blocking(i2c, i2cAddress, data, len, false) != (int)(len))
+        return false;
+
+    return true;
+}
+
+const pcf8523_Transport_t pcf8523_pico_transport = {
+    .read = pcf8523_pico_read,
+    .write = pcf8523_pico_write,
+};
+
+bool pcf8523_init_struct(pcf8523_t *pcf8523, i2c_inst_t *i2c, uint8_t i2cAddress, bool is24hFormat,
+                         bool checkFormat) {
+    if (!pcf8523 || !i2c)
+        return false;
+
+    pcf8523->i2c = i2c;
+
+    return pcf8523_init_struct_transport(pcf8523, &pcf8523_pico_transport, i2c, i2cAddress,
+                                         is24hFormat, checkFormat);
+}
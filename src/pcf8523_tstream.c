@@ -0,0 +1,266 @@
+#include "sensor/pcf8523_tstream.h"
+#include "sensor/pcf8523.h"
+
+#include <string.h>
+
+#define PCF8523_TSTREAM_KEYFRAME_BIT 1U
+
+static inline uint64_t pcf8523_tstream_zigzag(int64_t value) {
+    return ((uint64_t)value << 1) ^ (uint64_t)(value >> 63);
+}
+
+static inline int64_t pcf8523_tstream_unzigzag(uint64_t value) {
+    return (int64_t)(value >> 1) ^ -(int64_t)(value & 1);
+}
+
+static size_t pcf8523_tstream_put_varint(uint8_t *dst, uint64_t value) {
+    size_t len = 0;
+
+    while (value >= 0x80) {
+        dst[len++] = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+    dst[len++] = (uint8_t)value;
+
+    return len;
+}
+
+// Returns the number of bytes consumed, 0 if the varint is truncated or too long
+static inline size_t pcf8523_tstream_get_varint(const uint8_t *src, size_t avail,
+                                                uint64_t *value) {
+    if (avail > 0 && src[0] < 0x80) {
+        *value = src[0];
+        return 1;
+    }
+
+    uint64_t result = 0;
+    unsigned shift = 0;
+    for (size_t i = 0; i < avail && i < PCF8523_TSTREAM_MAX_TOKEN_SIZE; i++) {
+        result |= (uint64_t)(src[i] & 0x7F) << shift;
+        if (!(src[i] & 0x80)) {
+            *value = result;
+            return i + 1;
+        }
+        shift += 7;
+    }
+
+    return 0;
+}
+
+bool pcf8523_tstream_encoder_init(pcf8523_TstreamEncoder_t *enc, uint8_t *buffer, size_t capacity,
+                                  uint16_t keyframeInterval) {
+    if (!enc || !buffer || keyframeInterval == 0)
+        return false;
+
+    enc->buffer = buffer;
+    enc->capacity = capacity;
+    enc->keyframeInterval = keyframeInterval;
+    pcf8523_tstream_encoder_reset(enc);
+
+    return true;
+}
+
+void pcf8523_tstream_encoder_reset(pcf8523_TstreamEncoder_t *enc) {
+    if (!enc)
+        return;
+
+    // Every buffer starts with a keyframe so it can be decoded on its own
+    enc->length = 0;
+    enc->sinceKeyframe = enc->keyframeInterval;
+    enc->prevEpoch = 0;
+    enc->prevDelta = 0;
+}
+
+bool pcf8523_tstream_encode(pcf8523_TstreamEncoder_t *enc, uint64_t epoch) {
+    if (!enc || !enc->buffer)
+        return false;
+
+    uint8_t token[PCF8523_TSTREAM_MAX_TOKEN_SIZE];
+    size_t tokenLen;
+    int64_t delta = 0;
+    bool keyframe = enc->sinceKeyframe >= enc->keyframeInterval;
+
+    if (keyframe) {
+        if (epoch > (UINT64_MAX >> 1))
+            return false;
+        tokenLen = pcf8523_tstream_put_varint(token, (epoch << 1) | PCF8523_TSTREAM_KEYFRAME_BIT);
+    }
+    else {
+        delta = (int64_t)(epoch - enc->prevEpoch);
+        uint64_t dod = pcf8523_tstream_zigzag(delta - enc->prevDelta);
+        tokenLen = pcf8523_tstream_put_varint(token, dod << 1);
+    }
+
+    // Nothing is written if the token does not fit, the caller flushes and resets
+    if (enc->capacity - enc->length < tokenLen)
+        return false;
+
+    for (size_t i = 0; i < tokenLen; i++)
+        enc->buffer[enc->length + i] = token[i];
+    enc->length += tokenLen;
+
+    enc->prevEpoch = epoch;
+    enc->prevDelta = delta;
+    enc->sinceKeyframe = keyframe ? 1 : (uint16_t)(enc->sinceKeyframe + 1);
+
+    return true;
+}
+
+bool pcf8523_tstream_encode_datetime(pcf8523_TstreamEncoder_t *enc, const pcf8523_Datetime_t *dt,
+                                     uint16_t century) {
+    if (!enc || !dt)
+        return false;
+
+    return pcf8523_tstream_encode(enc, pcf8523_datetime_to_epoch(dt, century));
+}
+
+bool pcf8523_tstream_decoder_init(pcf8523_TstreamDecoder_t *dec, const uint8_t *data,
+                                  size_t length) {
+    if (!dec || (!data && length > 0))
+        return false;
+
+    dec->data = data;
+    dec->length = length;
+    dec->pos = 0;
+    dec->synced = false;
+    dec->prevEpoch = 0;
+    dec->prevDelta = 0;
+
+    return true;
+}
+
+bool pcf8523_tstream_decode(pcf8523_TstreamDecoder_t *dec, uint64_t *epochs, size_t maxEpochs,
+                            size_t *count) {
+    if (!dec || !epochs || !count)
+        return false;
+
+    const uint8_t *data = dec->data;
+    size_t pos = dec->pos;
+    size_t length = dec->length;
+    uint64_t epoch = dec->prevEpoch;
+    int64_t delta = dec->prevDelta;
+    size_t n = 0;
+    bool ok = true;
+
+    while (n < maxEpochs && pos < length) {
+        // Runs of one byte samples (bit 7 and the keyframe bit clear) are the common case, they
+        // are decoded in a tight loop without the varint and the keyframe branches
+        if (dec->synced) {
+            size_t end = pos + (maxEpochs - n);
+            if (end > length)
+                end = length;
+
+            // Eight samples at a time while a whole word of them is available
+            while (end - pos >= 8) {
+                uint64_t word;
+                memcpy(&word, &data[pos], sizeof(word));
+                if (word & 0x8181818181818181ULL)
+                    break;
+
+                for (unsigned i = 0; i < 8; i++) {
+                    delta += pcf8523_tstream_unzigzag((uint64_t)(data[pos + i] >> 1));
+                    epoch += (uint64_t)delta;
+                    epochs[n + i] = epoch;
+                }
+                pos += 8;
+                n += 8;
+            }
+
+            while (pos < end && !(data[pos] & 0x81)) {
+                delta += pcf8523_tstream_unzigzag((uint64_t)(data[pos++] >> 1));
+                epoch += (uint64_t)delta;
+                epochs[n++] = epoch;
+            }
+
+            if (pos == end)
+                break;
+        }
+
+        uint64_t token;
+        size_t used = pcf8523_tstream_get_varint(&data[pos], length - pos, &token);
+        if (used == 0) {
+            ok = false;
+            break;
+        }
+        pos += used;
+
+        if (token & PCF8523_TSTREAM_KEYFRAME_BIT) {
+            epoch = token >> 1;
+            delta = 0;
+            dec->synced = true;
+        }
+        else {
+            if (!dec->synced) {
+                ok = false;
+                break;
+            }
+            delta += pcf8523_tstream_unzigzag(token >> 1);
+            epoch += (uint64_t)delta;
+        }
+
+        epochs[n++] = epoch;
+    }
+
+    dec->pos = pos;
+    dec->prevEpoch = epoch;
+    dec->prevDelta = delta;
+    *count = n;
+
+    return ok;
+}
+
+// Offset of the first keyframe token starting at or after offset, length if there is none
+static size_t pcf8523_tstream_next_keyframe(const pcf8523_TstreamDecoder_t *dec, size_t offset,
+                                            uint64_t *epoch) {
+    // Skip the tail of a varint we landed in
+    while (offset > 0 && offset < dec->length && (dec->data[offset - 1] & 0x80))
+        offset++;
+
+    while (offset < dec->length) {
+        uint64_t token;
+        size_t used = pcf8523_tstream_get_varint(&dec->data[offset], dec->length - offset, &token);
+        if (used == 0)
+            return dec->length;
+
+        if (token & PCF8523_TSTREAM_KEYFRAME_BIT) {
+            *epoch = token >> 1;
+            return offset;
+        }
+        offset += used;
+    }
+
+    return dec->length;
+}
+
+bool pcf8523_tstream_seek(pcf8523_TstreamDecoder_t *dec, uint64_t epoch) {
+    if (!dec)
+        return false;
+
+    // Bisect on byte offsets for the last keyframe not after epoch
+    size_t best = 0;
+    size_t lo = 0;
+    size_t hi = dec->length;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        uint64_t keyEpoch = 0;
+        size_t key = pcf8523_tstream_next_keyframe(dec, mid, &keyEpoch);
+
+        if (key >= hi) {
+            hi = mid;
+        }
+        else if (keyEpoch <= epoch) {
+            best = key;
+            lo = key + 1;
+        }
+        else {
+            hi = mid;
+        }
+    }
+
+    dec->pos = best;
+    dec->synced = false;
+    dec->prevEpoch = 0;
+    dec->prevDelta = 0;
+
+    return true;
+}
@@ -0,0 +1,347 @@
+#include "sensor/pcf8523_tz.h"
+#include "sensor/pcf8523.h"
+
+#define PCF8523_TZ_SECONDS_PER_DAY 86400L
+#define PCF8523_TZ_DEFAULT_RULE_TIME 7200L // 02:00:00
+
+typedef enum {
+    PCF8523_TZ_RULE_JULIAN_NO_LEAP = 0, // Jn, 1..365, February 29 is never counted
+    PCF8523_TZ_RULE_JULIAN,             // n, 0..365
+    PCF8523_TZ_RULE_MONTH_WEEK_DAY      // Mm.w.d
+} pcf8523_TzRuleType_t;
+
+typedef struct {
+    pcf8523_TzRuleType_t type;
+    uint16_t day;
+    uint8_t month;
+    uint8_t week;
+    int32_t time; // Local time of the change, in the offset in effect before it
+} pcf8523_TzRule_t;
+
+static inline bool pcf8523_tz_is_leap(uint16_t year) {
+    return (year % 4 == 0 && year % 100 != 0) || (year % 400 == 0);
+}
+
+static uint8_t pcf8523_tz_month_days(uint16_t year, uint8_t month) {
+    static const uint8_t monthDays[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+
+    if (month == 2 && pcf8523_tz_is_leap(year))
+        return 29;
+
+    return monthDays[month - 1];
+}
+
+static int64_t pcf8523_tz_days_from_civil(uint16_t year, uint8_t month, uint8_t day) {
+    pcf8523_Datetime_t dt = {0};
+    dt.day = day;
+    dt.month = month;
+    dt.year = (uint8_t)(year - PCF8523_TZ_FIRST_YEAR);
+    dt.hourMode = PCF8523_HOUR_MODE_24H;
+
+    return (int64_t)(pcf8523_datetime_to_epoch(&dt, PCF8523_TZ_FIRST_YEAR) /
+                     PCF8523_TZ_SECONDS_PER_DAY);
+}
+
+static bool pcf8523_tz_parse_number(const char **p, int32_t max, int32_t *value) {
+    int32_t result = 0;
+    bool any = false;
+
+    while (**p >= '0' && **p <= '9') {
+        result = result * 10 + (**p - '0');
+        if (result > max)
+            return false;
+        (*p)++;
+        any = true;
+    }
+
+    *value = result;
+
+    return any;
+}
+
+static bool pcf8523_tz_parse_name(const char **p) {
+    const char *start = *p;
+
+    if (**p == '<') {
+        (*p)++;
+        while (**p && **p != '>')
+            (*p)++;
+        if (**p != '>')
+            return false;
+        (*p)++;
+        return *p - start >= 5; // "<" + at least 3 characters + ">"
+    }
+
+    while ((**p >= 'A' && **p <= 'Z') || (**p >= 'a' && **p <= 'z'))
+        (*p)++;
+
+    return *p - start >= 3;
+}
+
+// [+-]hh[:mm[:ss]], hours up to 167 as allowed for rule times
+static bool pcf8523_tz_parse_time(const char **p, int32_t *seconds) {
+    int32_t sign = 1;
+    int32_t hours, minutes = 0, secs = 0;
+
+    if (**p == '+' || **p == '-') {
+        if (**p == '-')
+            sign = -1;
+        (*p)++;
+    }
+
+    if (!pcf8523_tz_parse_number(p, 167, &hours))
+        return false;
+
+    if (**p == ':') {
+        (*p)++;
+        if (!pcf8523_tz_parse_number(p, 59, &minutes))
+            return false;
+
+        if (**p == ':') {
+            (*p)++;
+            if (!pcf8523_tz_parse_number(p, 59, &secs))
+                return false;
+        }
+    }
+
+    *seconds = sign * (hours * 3600 + minutes * 60 + secs);
+
+    return true;
+}
+
+static bool pcf8523_tz_parse_rule(const char **p, pcf8523_TzRule_t *rule) {
+    int32_t value;
+
+    if (**p == 'J') {
+        (*p)++;
+        if (!pcf8523_tz_parse_number(p, 365, &value) || value < 1)
+            return false;
+        rule->type = PCF8523_TZ_RULE_JULIAN_NO_LEAP;
+        rule->day = (uint16_t)value;
+    }
+    else if (**p == 'M') {
+        (*p)++;
+        if (!pcf8523_tz_parse_number(p, 12, &value) || value < 1 || **p != '.')
+            return false;
+        rule->month = (uint8_t)value;
+        (*p)++;
+
+        if (!pcf8523_tz_parse_number(p, 5, &value) || value < 1 || **p != '.')
+            return false;
+        rule->week = (uint8_t)value;
+        (*p)++;
+
+        if (!pcf8523_tz_parse_number(p, 6, &value))
+            return false;
+        rule->day = (uint16_t)value;
+        rule->type = PCF8523_TZ_RULE_MONTH_WEEK_DAY;
+    }
+    else {
+        if (!pcf8523_tz_parse_number(p, 365, &value))
+            return false;
+        rule->type = PCF8523_TZ_RULE_JULIAN;
+        rule->day = (uint16_t)value;
+    }
+
+    rule->time = PCF8523_TZ_DEFAULT_RULE_TIME;
+    if (**p == '/') {
+        (*p)++;
+        if (!pcf8523_tz_parse_time(p, &rule->time))
+            return false;
+    }
+
+    return true;
+}
+
+// Local epoch of the rule in the given year
+static int64_t pcf8523_tz_rule_local(const pcf8523_TzRule_t *rule, uint16_t year) {
+    int64_t days = pcf8523_tz_days_from_civil(year, 1, 1);
+
+    switch (rule->type) {
+        case PCF8523_TZ_RULE_JULIAN_NO_LEAP:
+            days += rule->day - 1;
+            if (rule->day >= 60 && pcf8523_tz_is_leap(year))
+                days++;
+            break;
+
+        case PCF8523_TZ_RULE_JULIAN:
+            days += rule->day;
+            break;
+
+        case PCF8523_TZ_RULE_MONTH_WEEK_DAY: {
+            int64_t first = pcf8523_tz_days_from_civil(year, rule->month, 1);
+            // 1970-01-01 was a Thursday (4)
+            int64_t firstWeekDay = (first + 4) % 7;
+            int64_t mday = 1 + (rule->day - firstWeekDay + 7) % 7 + (rule->week - 1) * 7;
+            if (mday > pcf8523_tz_month_days(year, rule->month))
+                mday -= 7;
+            days = first + mday - 1;
+            break;
+        }
+    }
+
+    return days * PCF8523_TZ_SECONDS_PER_DAY + rule->time;
+}
+
+static void pcf8523_tz_add(pcf8523_Tz_t *tz, int64_t utc, int32_t offset, bool isDst) {
+    pcf8523_TzTransition_t *tr = &tz->transitions[tz->count++];
+
+    tr->utc = (uint32_t)utc;
+    tr->offset = offset;
+    tr->isDst = isDst;
+}
+
+bool pcf8523_tz_init(pcf8523_Tz_t *tz, const char *posixTz) {
+    if (!tz || !posixTz)
+        return false;
+
+    const char *p = posixTz;
+    int32_t stdOffset, dstOffset;
+    pcf8523_TzRule_t start, end;
+
+    tz->count = 0;
+    tz->cached = 0;
+
+    // POSIX offsets are west positive, they are negated to get local = UTC + offset
+    if (!pcf8523_tz_parse_name(&p) || !pcf8523_tz_parse_time(&p, &stdOffset))
+        return false;
+    stdOffset = -stdOffset;
+
+    tz->initialOffset = stdOffset;
+    tz->initialIsDst = false;
+
+    if (*p == '\0')
+        return true;
+
+    if (!pcf8523_tz_parse_name(&p))
+        return false;
+
+    dstOffset = stdOffset + 3600;
+    if (*p != ',' && *p != '\0') {
+        if (!pcf8523_tz_parse_time(&p, &dstOffset))
+            return false;
+        dstOffset = -dstOffset;
+    }
+
+    if (*p == '\0') {
+        // No rule given, use the POSIX default (US rules)
+        const char *defaultRule = "M3.2.0,M11.1.0";
+        const char *q = defaultRule;
+        if (!pcf8523_tz_parse_rule(&q, &start) || *q++ != ',' || !pcf8523_tz_parse_rule(&q, &end))
+            return false;
+    }
+    else {
+        if (*p++ != ',' || !pcf8523_tz_parse_rule(&p, &start) || *p++ != ',' ||
+            !pcf8523_tz_parse_rule(&p, &end) || *p != '\0')
+            return false;
+    }
+
+    for (uint16_t year = PCF8523_TZ_FIRST_YEAR; year <= PCF8523_TZ_LAST_YEAR; year++) {
+        // The start is given in standard time and the end in daylight time
+        int64_t dstStart = pcf8523_tz_rule_local(&start, year) - stdOffset;
+        int64_t dstEnd = pcf8523_tz_rule_local(&end, year) - dstOffset;
+
+        if (dstStart < dstEnd) {
+            pcf8523_tz_add(tz, dstStart, dstOffset, true);
+            pcf8523_tz_add(tz, dstEnd, stdOffset, false);
+        }
+        else {
+            // Southern hemisphere, the year starts in daylight time
+            pcf8523_tz_add(tz, dstEnd, stdOffset, false);
+            pcf8523_tz_add(tz, dstStart, dstOffset, true);
+        }
+    }
+
+    // The rules repeat, so before the first transition we are where the last one left us
+    tz->initialOffset = tz->transitions[tz->count - 1].offset;
+    tz->initialIsDst = tz->transitions[tz->count - 1].isDst;
+
+    return true;
+}
+
+int32_t pcf8523_tz_offset_at(pcf8523_Tz_t *tz, uint64_t utcEpoch, bool *isDst) {
+    if (!tz)
+        return 0;
+
+    uint16_t interval = tz->cached;
+    bool inCached = (interval == 0 || utcEpoch >= tz->transitions[interval - 1].utc) &&
+                    (interval == tz->count || utcEpoch < tz->transitions[interval].utc);
+
+    if (!inCached) {
+        // Number of transitions at or before utcEpoch
+        uint16_t lo = 0;
+        uint16_t hi = tz->count;
+        while (lo < hi) {
+            uint16_t mid = (uint16_t)(lo + (hi - lo) / 2);
+            if (tz->transitions[mid].utc <= utcEpoch)
+                lo = (uint16_t)(mid + 1);
+            else
+                hi = mid;
+        }
+        interval = lo;
+        tz->cached = interval;
+    }
+
+    if (interval == 0) {
+        if (isDst)
+            *isDst = tz->initialIsDst;
+        return tz->initialOffset;
+    }
+
+    if (isDst)
+        *isDst = tz->transitions[interval - 1].isDst;
+
+    return tz->transitions[interval - 1].offset;
+}
+
+bool pcf8523_tz_utc_to_local(pcf8523_Tz_t *tz, uint64_t utcEpoch, pcf8523_Datetime_t *local,
+                             bool *isDst) {
+    if (!tz || !local)
+        return false;
+
+    int32_t offset = pcf8523_tz_offset_at(tz, utcEpoch, isDst);
+    if (offset < 0 && utcEpoch < (uint64_t)(-(int64_t)offset))
+        return false;
+
+    *local = epoch_to_pcf8523_datetime((uint64_t)((int64_t)utcEpoch + offset));
+
+    return true;
+}
+
+bool pcf8523_tz_local_to_utc(pcf8523_Tz_t *tz, const pcf8523_Datetime_t *local, uint16_t century,
+                             uint64_t *utcEpoch) {
+    if (!tz || !local || !utcEpoch)
+        return false;
+
+    int64_t localEpoch = (int64_t)pcf8523_datetime_to_epoch(local, century);
+
+    // Transitions are months apart, so the offsets a day around cover both candidates
+    int32_t before = pcf8523_tz_offset_at(tz, (uint64_t)(localEpoch - PCF8523_TZ_SECONDS_PER_DAY),
+                                          NULL);
+    int32_t after = pcf8523_tz_offset_at(tz, (uint64_t)(localEpoch + PCF8523_TZ_SECONDS_PER_DAY),
+                                         NULL);
+
+    // A repeated local time resolves to its first occurrence
+    int64_t candidates[2] = {localEpoch - before, localEpoch - after};
+    if (candidates[1] < candidates[0]) {
+        int64_t tmp = candidates[0];
+        candidates[0] = candidates[1];
+        candidates[1] = tmp;
+    }
+
+    for (uint8_t i = 0; i < 2; i++) {
+        if (candidates[i] < 0)
+            continue;
+        if (localEpoch - pcf8523_tz_offset_at(tz, (uint64_t)candidates[i], NULL) == candidates[i]) {
+            *utcEpoch = (uint64_t)candidates[i];
+            return true;
+        }
+    }
+
+    // A local time skipped by a forward jump is moved forward by the size of the gap
+    if (localEpoch - before < 0)
+        return false;
+    *utcEpoch = (uint64_t)(localEpoch - before);
+
+    return true;
+}
@@ -0,0 +1,125 @@
+#include "sensor/pcf8523_watchdog.h"
+#include "pcf8523_private.h"
+#include "pico/stdlib.h"
+#include "sensor/pcf8523.h"
+
+// Only called once every token has checked in
+static bool pcf8523_watchdog_kick(pcf8523_Watchdog_t *wdt, uint64_t now) {
+    // Cleared before the write, a check-in made while it runs counts for the next period
+    for (uint8_t i = 0; i < wdt->tokenCount; i++)
+        wdt->checkedIn[i] = false;
+
+    // Writing the Timer A value register reloads the watchdog countdown
+    if (!pcf8523_write_register(wdt->pcf8523, PCF8523_TMR_A_REF, wdt->period.value)) {
+        // Nothing was reloaded, the check-ins still stand for the retry
+        for (uint8_t i = 0; i < wdt->tokenCount; i++)
+            wdt->checkedIn[i] = true;
+        return false;
+    }
+
+    // The timestamp is taken before the write, so the tracked budget errs on the safe side
+    wdt->lastKickUs = now;
+    wdt->kicks++;
+
+    return true;
+}
+
+bool pcf8523_watchdog_start(pcf8523_Watchdog_t *wdt, pcf8523_t *pcf8523,
+                            const pcf8523_TimerAValue *period, uint32_t thresholdUs) {
+    if (!wdt || !pcf8523 || !period)
+        return false;
+
+    if (period->value < 2)
+        return false;
+
+    // The first source clock tick after a reload can be cut short by the prescaler phase
+    uint64_t budget = pcf8523_timer_duration_us(period->sourceFreq, period->value) -
+                      pcf8523_timer_duration_us(period->sourceFreq, 1);
+    if (thresholdUs == 0 || thresholdUs >= budget)
+        return false;
+
+    wdt->pcf8523 = pcf8523;
+    wdt->period = *period;
+    wdt->budgetUs = budget;
+    wdt->thresholdUs = thresholdUs;
+    wdt->tokenCount = 0;
+    wdt->minMarginUs = (int64_t)budget;
+    wdt->kicks = 0;
+    wdt->services = 0;
+
+    if (!pcf8523_set_timer_a_mode(pcf8523, PCF8523_TMR_A_WATCHDOG))
+        return false;
+
+    if (!pcf8523_enable_interrupt_source(pcf8523, PCF8523_CTRL2_REG,
+                                         PCF8523_CTRL2_ENABLE_WATCHDOG_TMR_A_INT_MASK, true))
+        return false;
+
+    uint64_t now = time_us_64();
+    if (!pcf8523_set_timer_a_duration(pcf8523, &wdt->period))
+        return false;
+    wdt->lastKickUs = now;
+
+    return true;
+}
+
+bool pcf8523_watchdog_stop(pcf8523_Watchdog_t *wdt) {
+    if (!wdt || !wdt->pcf8523)
+        return false;
+
+    if (!pcf8523_enable_interrupt_source(wdt->pcf8523, PCF8523_CTRL2_REG,
+                                         PCF8523_CTRL2_ENABLE_WATCHDOG_TMR_A_INT_MASK, false))
+        return false;
+
+    return pcf8523_set_timer_a_mode(wdt->pcf8523, PCF8523_TMR_A_DISABLED);
+}
+
+bool pcf8523_watchdog_register_token(pcf8523_Watchdog_t *wdt, uint8_t *token) {
+    if (!wdt || !token || wdt->tokenCount >= PCF8523_WATCHDOG_MAX_TOKENS)
+        return false;
+
+    *token = wdt->tokenCount;
+    wdt->checkedIn[wdt->tokenCount] = false;
+    wdt->tokenCount++;
+
+    return true;
+}
+
+void pcf8523_watchdog_checkin(pcf8523_Watchdog_t *wdt, uint8_t token) {
+    // Every token owns its flag, so tasks on either core can check in without locking
+    if (wdt && token < wdt->tokenCount)
+        wdt->checkedIn[token] = true;
+}
+
+int64_t pcf8523_watchdog_remaining_us(const pcf8523_Watchdog_t *wdt) {
+    if (!wdt)
+        return 0;
+
+    return (int64_t)wdt->budgetUs - (int64_t)(time_us_64() - wdt->lastKickUs);
+}
+
+bool pcf8523_watchdog_service(pcf8523_Watchdog_t *wdt) {
+    if (!wdt || !wdt->pcf8523)
+        return false;
+
+    wdt->services++;
+
+    uint64_t now = time_us_64();
+    int64_t remaining = (int64_t)wdt->budgetUs - (int64_t)(now - wdt->lastKickUs);
+
+    if (remaining >= (int64_t)wdt->thresholdUs)
+        return true;
+
+    // A task that did not check in holds the kick back and lets the watchdog expire
+    for (uint8_t i = 0; i < wdt->tokenCount; i++) {
+        if (!wdt->checkedIn[i])
+            return true;
+    }
+
+    if (!pcf8523_watchdog_kick(wdt, now))
+        return false;
+
+    if (remaining < wdt->minMarginUs)
+        wdt->minMarginUs = remaining;
+
+    return true;
+}
@@ -0,0 +1,74 @@
+# Prints the text/data/bss contribution of every sensor_pcf8523 object.
+# Usage: cmake -DSIZE_TOOL=<size> -DOBJECTS=<obj>|<obj>... -P size_report.cmake
+
+string(REPLACE "|" ";" OBJECTS "${OBJECTS}")
+
+set(BLANKS "                    ")
+
+# Left aligns TEXT to WIDTH columns
+function(pad_right VAR TEXT WIDTH)
+    string(LENGTH "${TEXT}" LEN)
+    math(EXPR PAD "${WIDTH} - ${LEN}")
+    if(PAD LESS 1)
+        set(PAD 1)
+    endif()
+    string(SUBSTRING "${BLANKS}" 0 ${PAD} SPACES)
+    set(${VAR} "${TEXT}${SPACES}" PARENT_SCOPE)
+endfunction()
+
+# Right aligns TEXT to WIDTH columns
+function(pad_left VAR TEXT WIDTH)
+    string(LENGTH "${TEXT}" LEN)
+    math(EXPR PAD "${WIDTH} - ${LEN}")
+    if(PAD LESS 1)
+        set(PAD 1)
+    endif()
+    string(SUBSTRING "${BLANKS}" 0 ${PAD} SPACES)
+    set(${VAR} "${SPACES}${TEXT}" PARENT_SCOPE)
+endfunction()
+
+function(print_row NAME TEXT DATA BSS)
+    pad_right(NAME "${NAME}" 16)
+    pad_left(TEXT "${TEXT}" 8)
+    pad_left(DATA "${DATA}" 8)
+    pad_left(BSS "${BSS}" 8)
+    message("${NAME}${TEXT}${DATA}${BSS}")
+endfunction()
+
+set(TOTAL_TEXT 0)
+set(TOTAL_DATA 0)
+set(TOTAL_BSS 0)
+
+print_row("subsystem" "text" "data" "bss")
+
+foreach(OBJECT ${OBJECTS})
+    execute_process(
+        COMMAND ${SIZE_TOOL} ${OBJECT}
+        OUTPUT_VARIABLE SIZE_OUTPUT
+        RESULT_VARIABLE SIZE_RESULT
+    )
+    if(NOT SIZE_RESULT EQUAL 0)
+        message(FATAL_ERROR "${SIZE_TOOL} failed on ${OBJECT}")
+    endif()
+
+    # Berkeley format, the second line holds: text data bss dec hex filename
+    string(REGEX MATCH "\n[ \t]*([0-9]+)[ \t]+([0-9]+)[ \t]+([0-9]+)" SIZE_LINE "${SIZE_OUTPUT}")
+    set(TEXT ${CMAKE_MATCH_1})
+    set(DATA ${CMAKE_MATCH_2})
+    set(BSS ${CMAKE_MATCH_3})
+
+    get_filename_component(NAME ${OBJECT} NAME)
+    string(REGEX REPLACE "\\.c\\.o(bj)?$" "" NAME "${NAME}")
+    string(REGEX REPLACE "^pcf8523_?" "" NAME "${NAME}")
+    if(NAME STREQUAL "")
+        set(NAME "core")
+    endif()
+
+    math(EXPR TOTAL_TEXT "${TOTAL_TEXT} + ${TEXT}")
+    math(EXPR TOTAL_DATA "${TOTAL_DATA} + ${DATA}")
+    math(EXPR TOTAL_BSS "${TOTAL_BSS} + ${BSS}")
+
+    print_row("${NAME}" ${TEXT} ${DATA} ${BSS})
+endforeach()
+
+print_row("total" ${TOTAL_TEXT} ${TOTAL_DATA} ${TOTAL_BSS})